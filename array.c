@@ -422,6 +422,26 @@ concat_exp(int nargs, bool do_subsep)
 	}
 	len += (nargs - 1) * subseplen;
 
+	if (! do_subsep) {
+		/* add onto the first string, if it has room */
+		int ascii = (args_array[nargs]->flags & ASCIISTR);
+		NODE *t;
+
+		r = make_str_room(args_array[nargs], len);
+		s = r->stptr + r->stlen;
+		for (i = nargs - 1; i > 0; i--) {
+			t = args_array[i];
+			memcpy(s, t->stptr, t->stlen);
+			s += t->stlen;
+			ascii &= t->flags;
+			DEREF(t);
+		}
+		r->stlen = len;
+		r->stptr[len] = '\0';
+		r->flags |= ascii;
+		return r;
+	}
+
 	emalloc(str, char *, len + 1);
 
 	r = args_array[nargs];
@@ -646,7 +666,7 @@ do_delete(NODE *symbol, int nsubs)
 		adjust_fcall_stack(val, nsubs);  /* fix function call stack; See above. */
 		elem_new_reset(val);
 		if ((val->flags & (MALLOC|STRCUR)) == (MALLOC|STRCUR))
-			efree(val->stptr);
+			free_stptr(val);
 
 		mpfr_unset(val);
 #ifdef MEMDEBUG
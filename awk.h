@@ -185,6 +185,12 @@ typedef int off_t;
 extern time_t timegm(struct tm *tm);
 #endif
 
+/* for scanning sixteen bytes at a time in io.c and field.c */
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define USE_SSE2 1
+#endif /* defined(__SSE2__) && defined(__GNUC__) */
+
 #if defined(__MINGW32__)
 #include "nonposix.h"
 #endif /* defined(__MINGW32__) */
@@ -431,9 +437,13 @@ typedef struct exp_node {
 				// reuse; the elements aren't otherwise related
 				char32_t *wsp;
 				char *vn;
+				size_t *cxp;
 			} z;
 			size_t wslen;
-			struct exp_node *typre;
+			union {	// likewise
+				struct exp_node *tr;
+				size_t cap;
+			} y;
 			enum commenttype comtype;
 		} val;
 	} sub;
@@ -518,6 +528,10 @@ typedef struct exp_node {
 		REGEX           = 0x080000,	/* this is a typed regex */
 		CONVFMT_FMT	= 0x0100000,	/* string formatted via CONVFMT */
 		OFMT_FMT	= 0x0200000,	/* string formatted via OFMT */
+		ASCIISTR	= 0x0400000,	/* string value is known to be all ASCII */
+		CHARIDX		= 0x0800000,	/* valid UTF-8, charidx is current */
+		STRVIEW		= 0x1000000,	/* stptr is in the string of strparent */
+		STRCAP		= 0x2000000,	/* stptr has strcap bytes, see make_str_room() */
 	} flags;
 	long valref;
 } NODE;
@@ -537,6 +551,8 @@ typedef struct exp_node {
 /* Node_func */
 #define fparms		sub.nodep.rn
 #define code_ptr    sub.nodep.r.iptr
+#define frame_pool	sub.nodep.x.extra	/* released frames kept for reuse */
+#define frame_pool_size	sub.nodep.cnt
 
 /* Node_regex, Node_dynregex */
 #define re_reg	sub.nodep.r.preg
@@ -552,7 +568,9 @@ typedef struct exp_node {
  * to '\0'. This is helpful when calling functions such as strtod that require
  * a NUL-terminated argument. In particular, field values $n for n > 0 and
  * n < NF will not have a NUL terminator, since they point into the $0 buffer.
- * All other strings are NUL-terminated.
+ * Neither do views (STRVIEW) made by substr() and split(), which point into
+ * the string they came from, nor strings that a concatenation has grown
+ * past in place (see make_str_room()).  All other strings are NUL-terminated.
  */
 #define stptr	sub.val.sp
 #define stlen	sub.val.slen
@@ -560,17 +578,20 @@ typedef struct exp_node {
 #define strndmode sub.val.rndmode
 #define wstptr	sub.val.z.wsp
 #define wstlen	sub.val.wslen
+#define charidx	sub.val.z.cxp	/* with CHARIDX; wstlen is the char count */
+#define strparent sub.val.y.tr	/* with STRVIEW; owns the text */
+#define strcap	sub.val.y.cap	/* with STRCAP; size of the buffer */
 
 /* Node_elem_new */
 #define elemnew_vname	sub.val.z.vn
-#define elemnew_parent	sub.val.typre
+#define elemnew_parent	sub.val.y.tr
 
 #ifdef HAVE_MPFR
 #define mpg_numbr	sub.val.nm.mpnum
 #define mpg_i		sub.val.nm.mpi
 #endif
 #define numbr		sub.val.nm.fltnum
-#define typed_re	sub.val.typre
+#define typed_re	sub.val.y.tr
 
 /*
  * If stfmt is set to STFMT_UNUSED, it means that the string representation
@@ -593,6 +614,7 @@ typedef struct exp_node {
 #define func_node    sub.nodep.x.extra
 #define prev_frame_size	sub.nodep.reflags
 #define reti         sub.nodep.l.li
+#define next_frame   sub.nodep.rn	/* link in func_node->frame_pool */
 
 /* Node_var: */
 #define var_value    lnode
@@ -705,6 +727,7 @@ typedef enum opcodeval {
 	Op_greater,
 	Op_leq,
 	Op_geq,
+	Op_cmp_num,		/* comparison expected to be of two numbers */
 	Op_match,
 	Op_match_rec,		/* match $0 */
 	Op_nomatch,
@@ -738,6 +761,9 @@ typedef enum opcodeval {
 	/* function call instruction */
 	Op_func_call,
 	Op_indirect_func_call,
+	Op_func_call_inline,	/* call followed by an inlined copy of the body */
+	Op_inline_return,	/* return from an inlined function body */
+	Op_tail_call,		/* `return f(...)' inside f */
 
 	Op_push,		/* scalar variable */
 	Op_push_arg,		/* variable type (scalar or array) argument to built-in */
@@ -746,6 +772,7 @@ typedef enum opcodeval {
 	Op_push_re,		/* regex */
 	Op_push_array,
 	Op_push_param,
+	Op_push_stack,		/* copy of an item on the runtime stack */
 	Op_push_lhs,
 	Op_subscript_lhs,
 	Op_field_spec_lhs,
@@ -754,6 +781,8 @@ typedef enum opcodeval {
 	Op_jmp,
 	Op_jmp_true,
 	Op_jmp_false,
+	Op_jmp_cmp_true,	/* Op_cmp_num followed by Op_jmp_true */
+	Op_jmp_cmp_false,	/* Op_cmp_num followed by Op_jmp_false */
 	Op_get_record,
 	Op_newfile,
 	Op_arrayfor_init,
@@ -924,9 +953,18 @@ typedef struct exp_instruction {
 /* Op_cond_pair */
 #define line_range      x.xi
 
-/* Op_func_call, Op_func */
+/* Op_func_call, Op_tail_call, Op_func */
 #define func_body       x.xn
 
+/* Op_func_call_inline */
+#define inline_last     d.di
+
+/* Op_push_stack */
+#define stack_offset    x.xl
+
+/* Op_cmp_num, Op_jmp_cmp_true, Op_jmp_cmp_false */
+#define cmp_type        x.xl
+
 /* Op_subscript */
 #define sub_count       d.dl
 
@@ -1048,6 +1086,10 @@ struct redirect {
 	int status;
 	struct redirect *prev;
 	struct redirect *next;
+	struct redirect *hnext;	/* next with the same hash, see io.c */
+	size_t hcode;		/* full hash code of value */
+	struct redirect *lru_prev;	/* open output files, see io.c */
+	struct redirect *lru_next;
 	const char *mode;
 	awk_output_buf_t output;
 };
@@ -1644,9 +1686,12 @@ extern void init_fields(void);
 extern void init_csv_fields(void);
 extern void set_record(const char *buf, size_t cnt, const awk_fieldwidth_info_t *);
 extern void reset_record(void);
+extern NODE *record_owner(const char *s, size_t len);
 extern void rebuild_record(void);
 extern void set_NF(void);
 extern NODE **get_field(long num, Func_ptr *assign);
+extern void set_field_projection(bool *wanted, long max);
+extern void print_field_projection(FILE *fp);
 extern NODE *do_split(int nargs);
 extern NODE *do_patsplit(int nargs);
 extern void set_FS(void);
@@ -1726,6 +1771,10 @@ extern char *find_source(const char *src, struct stat *stb, int *errcode, int is
 extern NODE *do_getline_redir(int intovar, enum redirval redirtype);
 extern NODE *do_getline(int intovar, IOBUF *iop);
 extern struct redirect *getredirect(const char *str, int len);
+extern void update_output_stats(void);
+extern pid_t spawn_shell(const char *command, int child_in, int child_out,
+		const int *close_fds, const sigset_t *sigmask,
+		const sigset_t *sigdefault);
 extern bool inrec(IOBUF *iop, int *errcode);
 extern int nextfile(IOBUF **curfile, bool skipping);
 extern bool is_non_fatal_std(FILE *fp);
@@ -1745,6 +1794,7 @@ extern void update_global_values();
 extern long getenv_long(const char *name);
 extern void after_beginfile(IOBUF **curfile);
 extern void set_current_namespace(const char *new_namespace);
+extern bool load_lazy_symbol(const char *name);
 
 /* mpfr.c */
 extern void set_PREC(void);
@@ -1810,8 +1860,13 @@ extern void pp_string_fp(Func_print print_func, FILE *fp, const char *str,
 /* node.c */
 extern NODE *r_force_number(NODE *n);
 extern NODE *r_format_val(const char *format, int index, int fmtflag, NODE *s);
+#define ITOA_BUFSIZE	24	/* room for any intmax_t, with sign */
+extern char *fast_itoa(intmax_t num, char *bufend);
 extern NODE *r_dupnode(NODE *n);
 extern NODE *make_str_node(const char *s, size_t len, int flags);
+extern NODE *make_str_view(NODE *n, const char *s, size_t len);
+extern void unshare_string(NODE *n);
+extern NODE *make_str_room(NODE *n, size_t len);
 extern NODE *make_bool_node(bool value);
 extern NODE *make_typed_regex(const char *re, size_t len);
 extern void *more_blocks(int id);
@@ -1824,7 +1879,13 @@ extern const char32_t *wstrstr(const char32_t *haystack, size_t hs_len,
 extern const char32_t *wcasestrstr(const char32_t *haystack, size_t hs_len,
 		const char32_t *needle, size_t needle_len);
 extern void r_free_wstr(NODE *n);
-#define free_wstr(n)	do { if ((n)->flags & WSTRCUR) r_free_wstr(n); } while(0)
+#define free_wstr(n)	do { if ((n)->flags & (WSTRCUR|ASCIISTR|CHARIDX)) r_free_wstr(n); } while(0)
+extern bool str2charidx(NODE *n);
+#define has_charidx(n)	(((n)->flags & CHARIDX) != 0 || str2charidx(n))
+extern size_t charidx_byte_offset(NODE *n, size_t charpos);
+extern size_t charidx_char_offset(NODE *n, size_t byteoff);
+extern bool ascii_only(const char *str, size_t len);
+extern bool ascii_case_is_plain(void);
 extern wint_t btowc_cache[];
 #define btowc_cache(x) btowc_cache[(x)&0xFF]
 extern void init_btowc_cache();
@@ -2094,6 +2155,34 @@ force_number(NODE *n)
 
 #endif /* GAWKDEBUG */
 
+/* free_stptr --- release the string value of n, which may be a view */
+
+static inline void
+free_stptr(NODE *n)
+{
+	if ((n->flags & STRVIEW) != 0) {
+		unref(n->strparent);
+		n->strparent = NULL;
+		n->flags &= ~STRVIEW;
+	} else {
+		efree(n->stptr);
+		n->flags &= ~STRCAP;
+	}
+}
+
+/*
+ * settle_string --- n is kept where its text is read as a C string, so
+ * make sure that it is NUL-terminated and that it stays that way.
+ */
+
+static inline void
+settle_string(NODE *n)
+{
+	if ((n->flags & STRVIEW) != 0)
+		unshare_string(n);
+	n->flags &= ~STRCAP;
+}
+
 
 /* fixtype --- make a node decide if it's a number or a string */
 
@@ -2143,6 +2232,31 @@ boolval(NODE *t)
 	return (t->stlen > 0);
 }
 
+/* str_is_ascii --- true if the string value of n has only ASCII characters */
+
+/*
+ * In a multibyte locale such a string has one character per byte, so
+ * the character-oriented builtins can work on the bytes directly and
+ * never build the wide string.  The answer is cached in ASCIISTR,
+ * which free_wstr() clears along with the wide string.
+ */
+
+static inline bool
+str_is_ascii(NODE *n)
+{
+	if ((n->flags & ASCIISTR) != 0 || n->stlen == 0)
+		return true;
+	if ((n->flags & (WSTRCUR|CHARIDX)) != 0 && n->wstlen != n->stlen)
+		return false;
+	if (! ascii_only(n->stptr, n->stlen))
+		return false;
+	n->flags |= ASCIISTR;
+	return true;
+}
+
+/* mb_string --- true if n must be treated as a multibyte string */
+#define mb_string(n)	(gawk_mb_cur_max > 1 && ! str_is_ascii(n))
+
 /* emalloc_real --- malloc with error checking */
 
 static inline void *
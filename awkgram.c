@@ -145,6 +145,7 @@ static INSTRUCTION *mk_assignment(INSTRUCTION *lhs, INSTRUCTION *rhs, INSTRUCTIO
 static INSTRUCTION *mk_getline(INSTRUCTION *op, INSTRUCTION *opt_var, INSTRUCTION *redir, int redirtype);
 static int count_expressions(INSTRUCTION **list, bool isarg);
 static INSTRUCTION *optimize_assignment(INSTRUCTION *exp);
+static void optimize_program(INSTRUCTION *code);
 static void add_lint(INSTRUCTION *list, LINTTYPE linttype);
 
 enum defref { FUNC_DEFINE, FUNC_USE, FUNC_EXT };
@@ -229,6 +230,11 @@ static bool called_from_eval = false;
 
 static bool include_use_current_namespace = false;
 
+/* the functions in the order they are defined, for optimize_program() */
+static NODE **func_defs = NULL;
+static int func_defs_count = 0;
+static int func_defs_size = 0;
+
 static inline INSTRUCTION *list_create(INSTRUCTION *x);
 static inline INSTRUCTION *list_append(INSTRUCTION *l, INSTRUCTION *x);
 static inline INSTRUCTION *list_prepend(INSTRUCTION *l, INSTRUCTION *x);
@@ -238,7 +244,7 @@ extern double fmod(double x, double y);
 
 #define YYSTYPE INSTRUCTION *
 
-#line 242 "awkgram.c"
+#line 248 "awkgram.c"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -336,65 +342,6 @@ extern int yydebug;
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Token kinds.  */
-#define YYEMPTY -2
-#define YYEOF 0
-#define YYerror 256
-#define YYUNDEF 257
-#define FUNC_CALL 258
-#define NAME 259
-#define REGEXP 260
-#define FILENAME 261
-#define YNUMBER 262
-#define YSTRING 263
-#define TYPED_REGEXP 264
-#define RELOP 265
-#define IO_OUT 266
-#define IO_IN 267
-#define ASSIGNOP 268
-#define ASSIGN 269
-#define MATCHOP 270
-#define CONCAT_OP 271
-#define SUBSCRIPT 272
-#define LEX_BEGIN 273
-#define LEX_END 274
-#define LEX_IF 275
-#define LEX_ELSE 276
-#define LEX_RETURN 277
-#define LEX_DELETE 278
-#define LEX_SWITCH 279
-#define LEX_CASE 280
-#define LEX_DEFAULT 281
-#define LEX_WHILE 282
-#define LEX_DO 283
-#define LEX_FOR 284
-#define LEX_BREAK 285
-#define LEX_CONTINUE 286
-#define LEX_PRINT 287
-#define LEX_PRINTF 288
-#define LEX_NEXT 289
-#define LEX_EXIT 290
-#define LEX_FUNCTION 291
-#define LEX_BEGINFILE 292
-#define LEX_ENDFILE 293
-#define LEX_GETLINE 294
-#define LEX_NEXTFILE 295
-#define LEX_IN 296
-#define LEX_AND 297
-#define LEX_OR 298
-#define INCREMENT 299
-#define DECREMENT 300
-#define LEX_BUILTIN 301
-#define LEX_LENGTH 302
-#define LEX_EOF 303
-#define LEX_INCLUDE 304
-#define LEX_EVAL 305
-#define LEX_LOAD 306
-#define LEX_NAMESPACE 307
-#define LEX_NSINCLUDE 308
-#define NEWLINE 309
-#define SLASH_BEFORE_EQUAL 310
-#define UNARY 311
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
@@ -956,27 +903,27 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   237,   237,   238,   243,   253,   257,   269,   277,   291,
-     302,   312,   322,   332,   358,   368,   370,   375,   385,   387,
-     392,   394,   396,   402,   406,   411,   441,   447,   453,   459,
-     468,   486,   487,   498,   504,   512,   513,   517,   517,   551,
-     550,   584,   599,   601,   606,   607,   627,   632,   633,   637,
-     648,   653,   660,   768,   819,   869,   995,  1017,  1038,  1048,
-    1058,  1068,  1079,  1092,  1110,  1109,  1126,  1144,  1144,  1253,
-    1253,  1286,  1294,  1295,  1301,  1302,  1309,  1314,  1327,  1342,
-    1344,  1352,  1359,  1361,  1369,  1378,  1380,  1389,  1390,  1398,
-    1403,  1403,  1416,  1423,  1436,  1440,  1462,  1463,  1469,  1470,
-    1479,  1480,  1485,  1490,  1507,  1509,  1511,  1518,  1519,  1525,
-    1526,  1531,  1533,  1540,  1542,  1550,  1555,  1566,  1567,  1572,
-    1574,  1581,  1583,  1591,  1596,  1606,  1607,  1612,  1613,  1618,
-    1625,  1629,  1631,  1633,  1646,  1663,  1670,  1677,  1679,  1684,
-    1686,  1688,  1696,  1698,  1703,  1705,  1710,  1712,  1714,  1771,
-    1773,  1775,  1777,  1779,  1781,  1783,  1785,  1799,  1804,  1809,
-    1828,  1834,  1836,  1838,  1840,  1842,  1844,  1849,  1853,  1885,
-    1893,  1899,  1905,  1918,  1919,  1920,  1925,  1930,  1934,  1938,
-    1953,  1974,  1979,  2016,  2053,  2054,  2060,  2061,  2066,  2068,
-    2075,  2092,  2109,  2111,  2118,  2123,  2129,  2141,  2153,  2162,
-    2166,  2171,  2175,  2179,  2183,  2188,  2189,  2193,  2197,  2201
+       0,   243,   243,   244,   249,   259,   263,   275,   283,   297,
+     308,   318,   328,   338,   364,   374,   376,   381,   391,   393,
+     398,   400,   402,   408,   412,   417,   447,   453,   459,   465,
+     474,   492,   493,   504,   510,   518,   519,   523,   523,   557,
+     556,   590,   605,   607,   612,   613,   633,   638,   639,   643,
+     654,   659,   666,   774,   825,   875,  1001,  1023,  1044,  1054,
+    1064,  1074,  1085,  1098,  1116,  1115,  1132,  1150,  1150,  1259,
+    1259,  1292,  1300,  1301,  1307,  1308,  1315,  1320,  1333,  1348,
+    1350,  1358,  1365,  1367,  1375,  1384,  1386,  1395,  1396,  1404,
+    1409,  1409,  1422,  1429,  1442,  1446,  1468,  1469,  1475,  1476,
+    1485,  1486,  1491,  1496,  1513,  1515,  1517,  1524,  1525,  1531,
+    1532,  1537,  1539,  1546,  1548,  1556,  1561,  1572,  1573,  1578,
+    1580,  1587,  1589,  1597,  1602,  1612,  1613,  1618,  1619,  1624,
+    1631,  1635,  1637,  1639,  1652,  1669,  1676,  1683,  1685,  1690,
+    1692,  1694,  1702,  1704,  1709,  1711,  1716,  1718,  1720,  1777,
+    1779,  1781,  1783,  1785,  1787,  1789,  1791,  1805,  1810,  1815,
+    1834,  1840,  1842,  1844,  1846,  1848,  1850,  1855,  1859,  1891,
+    1899,  1905,  1911,  1924,  1925,  1926,  1931,  1936,  1940,  1944,
+    1959,  1980,  1985,  2022,  2059,  2060,  2066,  2067,  2072,  2074,
+    2081,  2098,  2115,  2117,  2124,  2129,  2135,  2147,  2159,  2168,
+    2172,  2177,  2181,  2185,  2189,  2194,  2195,  2199,  2203,  2207
 };
 #endif
 
@@ -1964,22 +1911,22 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* program: %empty  */
-#line 237 "awkgram.y"
+#line 243 "awkgram.y"
           { yyval = NULL; }
-#line 1970 "awkgram.c"
+#line 1917 "awkgram.c"
     break;
 
   case 3: /* program: program rule  */
-#line 239 "awkgram.y"
+#line 245 "awkgram.y"
           {
 		rule = 0;
 		yyerrok;
 	  }
-#line 1979 "awkgram.c"
+#line 1926 "awkgram.c"
     break;
 
   case 4: /* program: program nls  */
-#line 244 "awkgram.y"
+#line 250 "awkgram.y"
           {
 		if (yyvsp[0] != NULL) {
 			if (yyvsp[-1] == NULL)
@@ -1989,19 +1936,19 @@ yyreduce:
 		}
 		yyval = yyvsp[-1];
 	  }
-#line 1993 "awkgram.c"
+#line 1940 "awkgram.c"
     break;
 
   case 5: /* program: program LEX_EOF  */
-#line 254 "awkgram.y"
+#line 260 "awkgram.y"
           {
 		next_sourcefile();
 	  }
-#line 2001 "awkgram.c"
+#line 1948 "awkgram.c"
     break;
 
   case 6: /* program: program error  */
-#line 258 "awkgram.y"
+#line 264 "awkgram.y"
           {
 		rule = 0;
 		/*
@@ -2010,11 +1957,11 @@ yyreduce:
 		 */
   		/* yyerrok; */
 	  }
-#line 2014 "awkgram.c"
+#line 1961 "awkgram.c"
     break;
 
   case 7: /* rule: pattern action  */
-#line 270 "awkgram.y"
+#line 276 "awkgram.y"
           {
 		(void) append_rule(yyvsp[-1], yyvsp[0]);
 		if (pending_comment != NULL) {
@@ -2022,11 +1969,11 @@ yyreduce:
 			pending_comment = NULL;
 		}
 	  }
-#line 2026 "awkgram.c"
+#line 1973 "awkgram.c"
     break;
 
   case 8: /* rule: pattern statement_term  */
-#line 278 "awkgram.y"
+#line 284 "awkgram.y"
           {
 		if (rule != Rule) {
 			msg(_("%s blocks must have an action part"), ruletab[rule]);
@@ -2040,11 +1987,11 @@ yyreduce:
 			(void) append_rule(yyvsp[-1], NULL);
 		}
 	  }
-#line 2044 "awkgram.c"
+#line 1991 "awkgram.c"
     break;
 
   case 9: /* rule: function_prologue action  */
-#line 292 "awkgram.y"
+#line 298 "awkgram.y"
           {
 		in_function = false;
 		(void) mk_function(yyvsp[-1], yyvsp[0]);
@@ -2055,11 +2002,11 @@ yyreduce:
 		}
 		yyerrok;
 	  }
-#line 2059 "awkgram.c"
+#line 2006 "awkgram.c"
     break;
 
   case 10: /* rule: '@' LEX_INCLUDE source statement_term  */
-#line 303 "awkgram.y"
+#line 309 "awkgram.y"
           {
 		want_source = false;
 		at_seen--;
@@ -2069,11 +2016,11 @@ yyreduce:
 		}
 		yyerrok;
 	  }
-#line 2073 "awkgram.c"
+#line 2020 "awkgram.c"
     break;
 
   case 11: /* rule: '@' LEX_NSINCLUDE source statement_term  */
-#line 313 "awkgram.y"
+#line 319 "awkgram.y"
           {
 		want_source = false;
 		at_seen--;
@@ -2083,11 +2030,11 @@ yyreduce:
 		}
 		yyerrok;
 	  }
-#line 2087 "awkgram.c"
+#line 2034 "awkgram.c"
     break;
 
   case 12: /* rule: '@' LEX_LOAD library statement_term  */
-#line 323 "awkgram.y"
+#line 329 "awkgram.y"
           {
 		want_source = false;
 		at_seen--;
@@ -2097,11 +2044,11 @@ yyreduce:
 		}
 		yyerrok;
 	  }
-#line 2101 "awkgram.c"
+#line 2048 "awkgram.c"
     break;
 
   case 13: /* rule: '@' LEX_NAMESPACE namespace statement_term  */
-#line 333 "awkgram.y"
+#line 339 "awkgram.y"
           {
 		/*
 		 * 1/2022:
@@ -2124,11 +2071,11 @@ yyreduce:
 
 		yyerrok;
 	  }
-#line 2128 "awkgram.c"
+#line 2075 "awkgram.c"
     break;
 
   case 14: /* source: FILENAME  */
-#line 359 "awkgram.y"
+#line 365 "awkgram.y"
           {
 		void *srcfile = NULL;
 
@@ -2138,23 +2085,23 @@ yyreduce:
 		bcfree(yyvsp[0]);
 		yyval = (INSTRUCTION *) srcfile;
 	  }
-#line 2142 "awkgram.c"
+#line 2089 "awkgram.c"
     break;
 
   case 15: /* source: FILENAME error  */
-#line 369 "awkgram.y"
+#line 375 "awkgram.y"
           { yyval = NULL; }
-#line 2148 "awkgram.c"
+#line 2095 "awkgram.c"
     break;
 
   case 16: /* source: error  */
-#line 371 "awkgram.y"
+#line 377 "awkgram.y"
           { yyval = NULL; }
-#line 2154 "awkgram.c"
+#line 2101 "awkgram.c"
     break;
 
   case 17: /* library: FILENAME  */
-#line 376 "awkgram.y"
+#line 382 "awkgram.y"
           {
 		void *srcfile;
 
@@ -2164,58 +2111,58 @@ yyreduce:
 		bcfree(yyvsp[0]);
 		yyval = (INSTRUCTION *) srcfile;
 	  }
-#line 2168 "awkgram.c"
+#line 2115 "awkgram.c"
     break;
 
   case 18: /* library: FILENAME error  */
-#line 386 "awkgram.y"
+#line 392 "awkgram.y"
           { yyval = NULL; }
-#line 2174 "awkgram.c"
+#line 2121 "awkgram.c"
     break;
 
   case 19: /* library: error  */
-#line 388 "awkgram.y"
+#line 394 "awkgram.y"
           { yyval = NULL; }
-#line 2180 "awkgram.c"
+#line 2127 "awkgram.c"
     break;
 
   case 20: /* namespace: FILENAME  */
-#line 393 "awkgram.y"
+#line 399 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 2186 "awkgram.c"
+#line 2133 "awkgram.c"
     break;
 
   case 21: /* namespace: FILENAME error  */
-#line 395 "awkgram.y"
+#line 401 "awkgram.y"
           { yyval = NULL; }
-#line 2192 "awkgram.c"
+#line 2139 "awkgram.c"
     break;
 
   case 22: /* namespace: error  */
-#line 397 "awkgram.y"
+#line 403 "awkgram.y"
           { yyval = NULL; }
-#line 2198 "awkgram.c"
+#line 2145 "awkgram.c"
     break;
 
   case 23: /* pattern: %empty  */
-#line 402 "awkgram.y"
+#line 408 "awkgram.y"
           {
 		rule = Rule;
 		yyval = NULL;
 	  }
-#line 2207 "awkgram.c"
+#line 2154 "awkgram.c"
     break;
 
   case 24: /* pattern: exp  */
-#line 407 "awkgram.y"
+#line 413 "awkgram.y"
           {
 		rule = Rule;
 	  }
-#line 2215 "awkgram.c"
+#line 2162 "awkgram.c"
     break;
 
   case 25: /* pattern: exp comma exp  */
-#line 412 "awkgram.y"
+#line 418 "awkgram.y"
           {
 		INSTRUCTION *tp;
 
@@ -2245,51 +2192,51 @@ yyreduce:
 			yyval = list_append(list_merge(yyvsp[-2], yyvsp[0]), tp);
 		rule = Rule;
 	  }
-#line 2249 "awkgram.c"
+#line 2196 "awkgram.c"
     break;
 
   case 26: /* pattern: LEX_BEGIN  */
-#line 442 "awkgram.y"
+#line 448 "awkgram.y"
           {
 		yyvsp[0]->in_rule = rule = BEGIN;
 		yyvsp[0]->source_file = source;
 		yyval = yyvsp[0];
 	  }
-#line 2259 "awkgram.c"
+#line 2206 "awkgram.c"
     break;
 
   case 27: /* pattern: LEX_END  */
-#line 448 "awkgram.y"
+#line 454 "awkgram.y"
           {
 		yyvsp[0]->in_rule = rule = END;
 		yyvsp[0]->source_file = source;
 		yyval = yyvsp[0];
 	  }
-#line 2269 "awkgram.c"
+#line 2216 "awkgram.c"
     break;
 
   case 28: /* pattern: LEX_BEGINFILE  */
-#line 454 "awkgram.y"
+#line 460 "awkgram.y"
           {
 		yyvsp[0]->in_rule = rule = BEGINFILE;
 		yyvsp[0]->source_file = source;
 		yyval = yyvsp[0];
 	  }
-#line 2279 "awkgram.c"
+#line 2226 "awkgram.c"
     break;
 
   case 29: /* pattern: LEX_ENDFILE  */
-#line 460 "awkgram.y"
+#line 466 "awkgram.y"
           {
 		yyvsp[0]->in_rule = rule = ENDFILE;
 		yyvsp[0]->source_file = source;
 		yyval = yyvsp[0];
 	  }
-#line 2289 "awkgram.c"
+#line 2236 "awkgram.c"
     break;
 
   case 30: /* action: l_brace statements r_brace opt_semi opt_nls  */
-#line 469 "awkgram.y"
+#line 475 "awkgram.y"
           {
 		INSTRUCTION *ip = make_braced_statements(yyvsp[-4], yyvsp[-3], yyvsp[-2]);
 
@@ -2304,11 +2251,11 @@ yyreduce:
 
 		yyval = ip;
 	  }
-#line 2308 "awkgram.c"
+#line 2255 "awkgram.c"
     break;
 
   case 32: /* func_name: FUNC_CALL  */
-#line 488 "awkgram.y"
+#line 494 "awkgram.y"
           {
 		const char *name = yyvsp[0]->lextok;
 		char *qname = qualify_name(name, strlen(name));
@@ -2319,36 +2266,36 @@ yyreduce:
 		}
 		yyval = yyvsp[0];
 	  }
-#line 2323 "awkgram.c"
+#line 2270 "awkgram.c"
     break;
 
   case 33: /* func_name: lex_builtin  */
-#line 499 "awkgram.y"
+#line 505 "awkgram.y"
           {
 		yyerror(_("`%s' is a built-in function, it cannot be redefined"),
 					tokstart);
 		YYABORT;
 	  }
-#line 2333 "awkgram.c"
+#line 2280 "awkgram.c"
     break;
 
   case 34: /* func_name: '@' LEX_EVAL  */
-#line 505 "awkgram.y"
+#line 511 "awkgram.y"
           {
 		yyval = yyvsp[0];
 		at_seen--;
 	  }
-#line 2342 "awkgram.c"
+#line 2289 "awkgram.c"
     break;
 
   case 37: /* $@1: %empty  */
-#line 517 "awkgram.y"
+#line 523 "awkgram.y"
                                      { want_param_names = FUNC_HEADER; }
-#line 2348 "awkgram.c"
+#line 2295 "awkgram.c"
     break;
 
   case 38: /* function_prologue: LEX_FUNCTION func_name '(' $@1 opt_param_list r_paren opt_nls  */
-#line 518 "awkgram.y"
+#line 524 "awkgram.y"
           {
 		INSTRUCTION *func_comment = NULL;
 		// Merge any comments found in the parameter list with those
@@ -2374,17 +2321,17 @@ yyreduce:
 		yyval = yyvsp[-6];
 		want_param_names = FUNC_BODY;
 	  }
-#line 2378 "awkgram.c"
+#line 2325 "awkgram.c"
     break;
 
   case 39: /* $@2: %empty  */
-#line 551 "awkgram.y"
+#line 557 "awkgram.y"
                 { want_regexp = true; }
-#line 2384 "awkgram.c"
+#line 2331 "awkgram.c"
     break;
 
   case 40: /* regexp: a_slash $@2 REGEXP  */
-#line 553 "awkgram.y"
+#line 559 "awkgram.y"
                 {
 		  NODE *n, *exp;
 		  char *re;
@@ -2413,11 +2360,11 @@ yyreduce:
 		  yyval->opcode = Op_match_rec;
 		  yyval->memory = n;
 		}
-#line 2417 "awkgram.c"
+#line 2364 "awkgram.c"
     break;
 
   case 41: /* typed_regexp: TYPED_REGEXP  */
-#line 585 "awkgram.y"
+#line 591 "awkgram.y"
                 {
 		  char *re;
 		  size_t len;
@@ -2430,23 +2377,23 @@ yyreduce:
 		  yyval->opcode = Op_push_re;
 		  yyval->memory = make_typed_regex(re, len);
 		}
-#line 2434 "awkgram.c"
+#line 2381 "awkgram.c"
     break;
 
   case 42: /* a_slash: '/'  */
-#line 600 "awkgram.y"
+#line 606 "awkgram.y"
           { bcfree(yyvsp[0]); }
-#line 2440 "awkgram.c"
+#line 2387 "awkgram.c"
     break;
 
   case 44: /* statements: %empty  */
-#line 606 "awkgram.y"
+#line 612 "awkgram.y"
           { yyval = NULL; }
-#line 2446 "awkgram.c"
+#line 2393 "awkgram.c"
     break;
 
   case 45: /* statements: statements statement  */
-#line 608 "awkgram.y"
+#line 614 "awkgram.y"
           {
 		if (yyvsp[0] == NULL) {
 			yyval = yyvsp[-1];
@@ -2466,29 +2413,29 @@ yyreduce:
 
 		yyerrok;
 	  }
-#line 2470 "awkgram.c"
+#line 2417 "awkgram.c"
     break;
 
   case 46: /* statements: statements error  */
-#line 628 "awkgram.y"
+#line 634 "awkgram.y"
           {	yyval = NULL; }
-#line 2476 "awkgram.c"
+#line 2423 "awkgram.c"
     break;
 
   case 47: /* statement_term: nls  */
-#line 632 "awkgram.y"
+#line 638 "awkgram.y"
                         { yyval = yyvsp[0]; }
-#line 2482 "awkgram.c"
+#line 2429 "awkgram.c"
     break;
 
   case 48: /* statement_term: semi opt_nls  */
-#line 633 "awkgram.y"
+#line 639 "awkgram.y"
                         { yyval = yyvsp[0]; }
-#line 2488 "awkgram.c"
+#line 2435 "awkgram.c"
     break;
 
   case 49: /* statement: semi opt_nls  */
-#line 638 "awkgram.y"
+#line 644 "awkgram.y"
           {
 		if (yyvsp[0] != NULL) {
 			INSTRUCTION *ip;
@@ -2499,31 +2446,31 @@ yyreduce:
 		} else
 			yyval = NULL;
 	  }
-#line 2503 "awkgram.c"
+#line 2450 "awkgram.c"
     break;
 
   case 50: /* statement: l_brace statements r_brace  */
-#line 649 "awkgram.y"
+#line 655 "awkgram.y"
           {
 		trailing_comment = yyvsp[0];	// NULL or comment
 		yyval = make_braced_statements(yyvsp[-2], yyvsp[-1], yyvsp[0]);
 	  }
-#line 2512 "awkgram.c"
+#line 2459 "awkgram.c"
     break;
 
   case 51: /* statement: if_statement  */
-#line 654 "awkgram.y"
+#line 660 "awkgram.y"
           {
 		if (do_pretty_print)
 			yyval = list_prepend(yyvsp[0], instruction(Op_exec_count));
 		else
 			yyval = yyvsp[0];
  	  }
-#line 2523 "awkgram.c"
+#line 2470 "awkgram.c"
     break;
 
   case 52: /* statement: LEX_SWITCH '(' exp r_paren opt_nls l_brace case_statements opt_nls r_brace  */
-#line 661 "awkgram.y"
+#line 667 "awkgram.y"
           {
 		INSTRUCTION *dflt, *curr = NULL, *cexp, *cstmt;
 		INSTRUCTION *ip, *nextc, *tbreak;
@@ -2631,11 +2578,11 @@ yyreduce:
 		break_allowed--;
 		fix_break_continue(ip, tbreak, NULL);
 	  }
-#line 2635 "awkgram.c"
+#line 2582 "awkgram.c"
     break;
 
   case 53: /* statement: LEX_WHILE '(' exp r_paren opt_nls statement  */
-#line 769 "awkgram.y"
+#line 775 "awkgram.y"
           {
 		/*
 		 *    -----------------
@@ -2686,11 +2633,11 @@ yyreduce:
 		continue_allowed--;
 		fix_break_continue(ip, tbreak, tcont);
 	  }
-#line 2690 "awkgram.c"
+#line 2637 "awkgram.c"
     break;
 
   case 54: /* statement: LEX_DO opt_nls statement LEX_WHILE '(' exp r_paren opt_nls  */
-#line 820 "awkgram.y"
+#line 826 "awkgram.y"
           {
 		/*
 		 *    -----------------
@@ -2740,11 +2687,11 @@ yyreduce:
 		/* else
 			$1 and $4 are NULLs */
 	  }
-#line 2744 "awkgram.c"
+#line 2691 "awkgram.c"
     break;
 
   case 55: /* statement: LEX_FOR '(' NAME LEX_IN simple_variable r_paren opt_nls statement  */
-#line 870 "awkgram.y"
+#line 876 "awkgram.y"
           {
 		INSTRUCTION *ip;
 		char *var_name = yyvsp[-5]->lextok;
@@ -2870,11 +2817,11 @@ regular_loop:
 		break_allowed--;
 		continue_allowed--;
 	  }
-#line 2874 "awkgram.c"
+#line 2821 "awkgram.c"
     break;
 
   case 56: /* statement: LEX_FOR '(' opt_simple_stmt semi opt_nls exp semi opt_nls opt_simple_stmt r_paren opt_nls statement  */
-#line 996 "awkgram.y"
+#line 1002 "awkgram.y"
           {
 		if (yyvsp[-7] != NULL) {
 			merge_comments(yyvsp[-7], NULL);
@@ -2896,11 +2843,11 @@ regular_loop:
 		break_allowed--;
 		continue_allowed--;
 	  }
-#line 2900 "awkgram.c"
+#line 2847 "awkgram.c"
     break;
 
   case 57: /* statement: LEX_FOR '(' opt_simple_stmt semi opt_nls semi opt_nls opt_simple_stmt r_paren opt_nls statement  */
-#line 1018 "awkgram.y"
+#line 1024 "awkgram.y"
           {
 		if (yyvsp[-6] != NULL) {
 			merge_comments(yyvsp[-6], NULL);
@@ -2921,22 +2868,22 @@ regular_loop:
 		break_allowed--;
 		continue_allowed--;
 	  }
-#line 2925 "awkgram.c"
+#line 2872 "awkgram.c"
     break;
 
   case 58: /* statement: non_compound_stmt  */
-#line 1039 "awkgram.y"
+#line 1045 "awkgram.y"
           {
 		if (do_pretty_print)
 			yyval = list_prepend(yyvsp[0], instruction(Op_exec_count));
 		else
 			yyval = yyvsp[0];
 	  }
-#line 2936 "awkgram.c"
+#line 2883 "awkgram.c"
     break;
 
   case 59: /* non_compound_stmt: LEX_BREAK statement_term  */
-#line 1049 "awkgram.y"
+#line 1055 "awkgram.y"
           {
 		if (! break_allowed)
 			error_ln(yyvsp[-1]->source_line,
@@ -2946,11 +2893,11 @@ regular_loop:
 		if (yyvsp[0] != NULL)
 			yyval = list_append(yyval, yyvsp[0]);
 	  }
-#line 2950 "awkgram.c"
+#line 2897 "awkgram.c"
     break;
 
   case 60: /* non_compound_stmt: LEX_CONTINUE statement_term  */
-#line 1059 "awkgram.y"
+#line 1065 "awkgram.y"
           {
 		if (! continue_allowed)
 			error_ln(yyvsp[-1]->source_line,
@@ -2960,11 +2907,11 @@ regular_loop:
 		if (yyvsp[0] != NULL)
 			yyval = list_append(yyval, yyvsp[0]);
 	  }
-#line 2964 "awkgram.c"
+#line 2911 "awkgram.c"
     break;
 
   case 61: /* non_compound_stmt: LEX_NEXT statement_term  */
-#line 1069 "awkgram.y"
+#line 1075 "awkgram.y"
           {
 		/* if inside function (rule = 0), resolve context at run-time */
 		if (rule && rule != Rule)
@@ -2975,11 +2922,11 @@ regular_loop:
 		if (yyvsp[0] != NULL)
 			yyval = list_append(yyval, yyvsp[0]);
 	  }
-#line 2979 "awkgram.c"
+#line 2926 "awkgram.c"
     break;
 
   case 62: /* non_compound_stmt: LEX_NEXTFILE statement_term  */
-#line 1080 "awkgram.y"
+#line 1086 "awkgram.y"
           {
 		/* if inside function (rule = 0), resolve context at run-time */
 		if (rule == BEGIN || rule == END || rule == ENDFILE)
@@ -2992,11 +2939,11 @@ regular_loop:
 		if (yyvsp[0] != NULL)
 			yyval = list_append(yyval, yyvsp[0]);
 	  }
-#line 2996 "awkgram.c"
+#line 2943 "awkgram.c"
     break;
 
   case 63: /* non_compound_stmt: LEX_EXIT opt_exp statement_term  */
-#line 1093 "awkgram.y"
+#line 1099 "awkgram.y"
           {
 		/* Initialize the two possible jump targets, the actual target
 		 * is resolved at run-time.
@@ -3013,20 +2960,20 @@ regular_loop:
 		if (yyvsp[0] != NULL)
 			yyval = list_append(yyval, yyvsp[0]);
 	  }
-#line 3017 "awkgram.c"
+#line 2964 "awkgram.c"
     break;
 
   case 64: /* $@3: %empty  */
-#line 1110 "awkgram.y"
+#line 1116 "awkgram.y"
           {
 		if (! in_function)
 			yyerror(_("`return' used outside function context"));
 	  }
-#line 3026 "awkgram.c"
+#line 2973 "awkgram.c"
     break;
 
   case 65: /* non_compound_stmt: LEX_RETURN $@3 opt_fcall_exp statement_term  */
-#line 1113 "awkgram.y"
+#line 1119 "awkgram.y"
                                          {
 		if (called_from_eval)
 			yyvsp[-3]->opcode = Op_K_return_from_eval;
@@ -3040,28 +2987,28 @@ regular_loop:
 		if (yyvsp[0] != NULL)
 			yyval = list_append(yyval, yyvsp[0]);
 	  }
-#line 3044 "awkgram.c"
+#line 2991 "awkgram.c"
     break;
 
   case 66: /* non_compound_stmt: simple_stmt statement_term  */
-#line 1127 "awkgram.y"
+#line 1133 "awkgram.y"
           {
 		if (yyvsp[0] != NULL)
 			yyval = list_append(yyvsp[-1], yyvsp[0]);
 		else
 			yyval = yyvsp[-1];
 	  }
-#line 3055 "awkgram.c"
+#line 3002 "awkgram.c"
     break;
 
   case 67: /* $@4: %empty  */
-#line 1144 "awkgram.y"
+#line 1150 "awkgram.y"
                 { in_print = true; in_parens = 0; }
-#line 3061 "awkgram.c"
+#line 3008 "awkgram.c"
     break;
 
   case 68: /* simple_stmt: print $@4 print_expression_list output_redir  */
-#line 1145 "awkgram.y"
+#line 1151 "awkgram.y"
           {
 		static bool warned = false;
 
@@ -3169,17 +3116,17 @@ regular_print:
 			}
 		}
 	  }
-#line 3173 "awkgram.c"
+#line 3120 "awkgram.c"
     break;
 
   case 69: /* $@5: %empty  */
-#line 1253 "awkgram.y"
+#line 1259 "awkgram.y"
                           { sub_counter = 0; }
-#line 3179 "awkgram.c"
+#line 3126 "awkgram.c"
     break;
 
   case 70: /* simple_stmt: LEX_DELETE NAME $@5 delete_subscript_list  */
-#line 1254 "awkgram.y"
+#line 1260 "awkgram.y"
           {
 		char *arr = yyvsp[-2]->lextok;
 
@@ -3212,54 +3159,54 @@ regular_print:
 			yyval = list_append(list_append(yyvsp[0], yyvsp[-2]), yyvsp[-3]);
 		}
 	  }
-#line 3216 "awkgram.c"
+#line 3163 "awkgram.c"
     break;
 
   case 71: /* simple_stmt: exp  */
-#line 1287 "awkgram.y"
+#line 1293 "awkgram.y"
           {
 		yyval = optimize_assignment(yyvsp[0]);
 	  }
-#line 3224 "awkgram.c"
+#line 3171 "awkgram.c"
     break;
 
   case 72: /* opt_simple_stmt: %empty  */
-#line 1294 "awkgram.y"
+#line 1300 "awkgram.y"
           { yyval = NULL; }
-#line 3230 "awkgram.c"
+#line 3177 "awkgram.c"
     break;
 
   case 73: /* opt_simple_stmt: simple_stmt  */
-#line 1296 "awkgram.y"
+#line 1302 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3236 "awkgram.c"
+#line 3183 "awkgram.c"
     break;
 
   case 74: /* case_statements: %empty  */
-#line 1301 "awkgram.y"
+#line 1307 "awkgram.y"
           { yyval = NULL; }
-#line 3242 "awkgram.c"
+#line 3189 "awkgram.c"
     break;
 
   case 75: /* case_statements: case_statements case_statement  */
-#line 1303 "awkgram.y"
+#line 1309 "awkgram.y"
           {
 		if (yyvsp[-1] == NULL)
 			yyval = list_create(yyvsp[0]);
 		else
 			yyval = list_prepend(yyvsp[-1], yyvsp[0]);
 	  }
-#line 3253 "awkgram.c"
+#line 3200 "awkgram.c"
     break;
 
   case 76: /* case_statements: case_statements error  */
-#line 1310 "awkgram.y"
+#line 1316 "awkgram.y"
           { yyval = NULL; }
-#line 3259 "awkgram.c"
+#line 3206 "awkgram.c"
     break;
 
   case 77: /* case_statement: LEX_CASE case_value colon opt_nls statements  */
-#line 1315 "awkgram.y"
+#line 1321 "awkgram.y"
           {
 		INSTRUCTION *casestmt = yyvsp[0];
 		if (yyvsp[0] == NULL)
@@ -3272,11 +3219,11 @@ regular_print:
 		bcfree(yyvsp[-2]);
 		yyval = yyvsp[-4];
 	  }
-#line 3276 "awkgram.c"
+#line 3223 "awkgram.c"
     break;
 
   case 78: /* case_statement: LEX_DEFAULT colon opt_nls statements  */
-#line 1328 "awkgram.y"
+#line 1334 "awkgram.y"
           {
 		INSTRUCTION *casestmt = yyvsp[0];
 		if (yyvsp[0] == NULL)
@@ -3288,17 +3235,17 @@ regular_print:
 		yyvsp[-3]->comment = yyvsp[-1];
 		yyval = yyvsp[-3];
 	  }
-#line 3292 "awkgram.c"
+#line 3239 "awkgram.c"
     break;
 
   case 79: /* case_value: YNUMBER  */
-#line 1343 "awkgram.y"
+#line 1349 "awkgram.y"
           {	yyval = yyvsp[0]; }
-#line 3298 "awkgram.c"
+#line 3245 "awkgram.c"
     break;
 
   case 80: /* case_value: '-' YNUMBER  */
-#line 1345 "awkgram.y"
+#line 1351 "awkgram.y"
           {
 		NODE *n = yyvsp[0]->memory;
 		(void) force_number(n);
@@ -3306,28 +3253,28 @@ regular_print:
 		bcfree(yyvsp[-1]);
 		yyval = yyvsp[0];
 	  }
-#line 3310 "awkgram.c"
+#line 3257 "awkgram.c"
     break;
 
   case 81: /* case_value: '+' YNUMBER  */
-#line 1353 "awkgram.y"
+#line 1359 "awkgram.y"
           {
 		NODE *n = yyvsp[0]->lasti->memory;
 		bcfree(yyvsp[-1]);
 		add_sign_to_num(n, '+');
 		yyval = yyvsp[0];
 	  }
-#line 3321 "awkgram.c"
+#line 3268 "awkgram.c"
     break;
 
   case 82: /* case_value: YSTRING  */
-#line 1360 "awkgram.y"
+#line 1366 "awkgram.y"
           {	yyval = yyvsp[0]; }
-#line 3327 "awkgram.c"
+#line 3274 "awkgram.c"
     break;
 
   case 83: /* case_value: regexp  */
-#line 1362 "awkgram.y"
+#line 1368 "awkgram.y"
           {
 		if (yyvsp[0]->memory->type == Node_regex)
 			yyvsp[0]->opcode = Op_push_re;
@@ -3335,57 +3282,57 @@ regular_print:
 			yyvsp[0]->opcode = Op_push;
 		yyval = yyvsp[0];
 	  }
-#line 3339 "awkgram.c"
+#line 3286 "awkgram.c"
     break;
 
   case 84: /* case_value: typed_regexp  */
-#line 1370 "awkgram.y"
+#line 1376 "awkgram.y"
           {
 		assert((yyvsp[0]->memory->flags & REGEX) == REGEX);
 		yyvsp[0]->opcode = Op_push_re;
 		yyval = yyvsp[0];
 	  }
-#line 3349 "awkgram.c"
+#line 3296 "awkgram.c"
     break;
 
   case 85: /* print: LEX_PRINT  */
-#line 1379 "awkgram.y"
+#line 1385 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3355 "awkgram.c"
+#line 3302 "awkgram.c"
     break;
 
   case 86: /* print: LEX_PRINTF  */
-#line 1381 "awkgram.y"
+#line 1387 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3361 "awkgram.c"
+#line 3308 "awkgram.c"
     break;
 
   case 88: /* print_expression_list: '(' expression_list r_paren  */
-#line 1391 "awkgram.y"
+#line 1397 "awkgram.y"
           {
 		yyval = yyvsp[-1];
 	  }
-#line 3369 "awkgram.c"
+#line 3316 "awkgram.c"
     break;
 
   case 89: /* output_redir: %empty  */
-#line 1398 "awkgram.y"
+#line 1404 "awkgram.y"
           {
 		in_print = false;
 		in_parens = 0;
 		yyval = NULL;
 	  }
-#line 3379 "awkgram.c"
+#line 3326 "awkgram.c"
     break;
 
   case 90: /* $@6: %empty  */
-#line 1403 "awkgram.y"
+#line 1409 "awkgram.y"
                  { in_print = false; in_parens = 0; }
-#line 3385 "awkgram.c"
+#line 3332 "awkgram.c"
     break;
 
   case 91: /* output_redir: IO_OUT $@6 common_exp  */
-#line 1404 "awkgram.y"
+#line 1410 "awkgram.y"
           {
 		if (yyvsp[-2]->redir_type == redirect_twoway
 		    	&& yyvsp[0]->lasti->opcode == Op_K_getline_redir
@@ -3395,22 +3342,22 @@ regular_print:
 			lintwarn(_("concatenation as I/O `>' redirection target is ambiguous"));
 		yyval = list_prepend(yyvsp[0], yyvsp[-2]);
 	  }
-#line 3399 "awkgram.c"
+#line 3346 "awkgram.c"
     break;
 
   case 92: /* if_statement: LEX_IF '(' exp r_paren opt_nls statement  */
-#line 1417 "awkgram.y"
+#line 1423 "awkgram.y"
           {
 		if (yyvsp[-1] != NULL)
 			yyvsp[-5]->comment = yyvsp[-1];
 		add_lint(yyvsp[-3], LINT_assign_in_cond);
 		yyval = mk_condition(yyvsp[-3], yyvsp[-5], yyvsp[0], NULL, NULL);
 	  }
-#line 3410 "awkgram.c"
+#line 3357 "awkgram.c"
     break;
 
   case 93: /* if_statement: LEX_IF '(' exp r_paren opt_nls statement LEX_ELSE opt_nls statement  */
-#line 1425 "awkgram.y"
+#line 1431 "awkgram.y"
           {
 		if (yyvsp[-4] != NULL)
 			yyvsp[-8]->comment = yyvsp[-4];
@@ -3419,19 +3366,19 @@ regular_print:
 		add_lint(yyvsp[-6], LINT_assign_in_cond);
 		yyval = mk_condition(yyvsp[-6], yyvsp[-8], yyvsp[-3], yyvsp[-2], yyvsp[0]);
 	  }
-#line 3423 "awkgram.c"
+#line 3370 "awkgram.c"
     break;
 
   case 94: /* nls: NEWLINE  */
-#line 1437 "awkgram.y"
+#line 1443 "awkgram.y"
           {
 		yyval = yyvsp[0];
 	  }
-#line 3431 "awkgram.c"
+#line 3378 "awkgram.c"
     break;
 
   case 95: /* nls: nls NEWLINE  */
-#line 1441 "awkgram.y"
+#line 1447 "awkgram.y"
           {
 		if (yyvsp[-1] != NULL && yyvsp[0] != NULL) {
 			if (yyvsp[-1]->memory->comment_type == EOL_COMMENT) {
@@ -3449,59 +3396,59 @@ regular_print:
 		} else
 			yyval = NULL;
 	  }
-#line 3453 "awkgram.c"
+#line 3400 "awkgram.c"
     break;
 
   case 96: /* opt_nls: %empty  */
-#line 1462 "awkgram.y"
+#line 1468 "awkgram.y"
           { yyval = NULL; }
-#line 3459 "awkgram.c"
+#line 3406 "awkgram.c"
     break;
 
   case 97: /* opt_nls: nls  */
-#line 1464 "awkgram.y"
+#line 1470 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3465 "awkgram.c"
+#line 3412 "awkgram.c"
     break;
 
   case 98: /* input_redir: %empty  */
-#line 1469 "awkgram.y"
+#line 1475 "awkgram.y"
           { yyval = NULL; }
-#line 3471 "awkgram.c"
+#line 3418 "awkgram.c"
     break;
 
   case 99: /* input_redir: '<' simp_exp  */
-#line 1471 "awkgram.y"
+#line 1477 "awkgram.y"
           {
 		bcfree(yyvsp[-1]);
 		yyval = yyvsp[0];
 	  }
-#line 3480 "awkgram.c"
+#line 3427 "awkgram.c"
     break;
 
   case 100: /* opt_param_list: %empty  */
-#line 1479 "awkgram.y"
+#line 1485 "awkgram.y"
           { yyval = NULL; }
-#line 3486 "awkgram.c"
+#line 3433 "awkgram.c"
     break;
 
   case 101: /* opt_param_list: param_list  */
-#line 1481 "awkgram.y"
+#line 1487 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3492 "awkgram.c"
+#line 3439 "awkgram.c"
     break;
 
   case 102: /* param_list: NAME  */
-#line 1486 "awkgram.y"
+#line 1492 "awkgram.y"
           {
 		yyvsp[0]->param_count = 0;
 		yyval = list_create(yyvsp[0]);
 	  }
-#line 3501 "awkgram.c"
+#line 3448 "awkgram.c"
     break;
 
   case 103: /* param_list: param_list comma NAME  */
-#line 1491 "awkgram.y"
+#line 1497 "awkgram.y"
           {
 		if (yyvsp[-2] != NULL && yyvsp[0] != NULL) {
 			yyvsp[0]->param_count = yyvsp[-2]->lasti->param_count + 1;
@@ -3518,76 +3465,76 @@ regular_print:
 		} else
 			yyval = NULL;
 	  }
-#line 3522 "awkgram.c"
+#line 3469 "awkgram.c"
     break;
 
   case 104: /* param_list: error  */
-#line 1508 "awkgram.y"
+#line 1514 "awkgram.y"
           { yyval = NULL; }
-#line 3528 "awkgram.c"
+#line 3475 "awkgram.c"
     break;
 
   case 105: /* param_list: param_list error  */
-#line 1510 "awkgram.y"
+#line 1516 "awkgram.y"
           { yyval = yyvsp[-1]; }
-#line 3534 "awkgram.c"
+#line 3481 "awkgram.c"
     break;
 
   case 106: /* param_list: param_list comma error  */
-#line 1512 "awkgram.y"
+#line 1518 "awkgram.y"
           { yyval = yyvsp[-2]; }
-#line 3540 "awkgram.c"
+#line 3487 "awkgram.c"
     break;
 
   case 107: /* opt_exp: %empty  */
-#line 1518 "awkgram.y"
+#line 1524 "awkgram.y"
           { yyval = NULL; }
-#line 3546 "awkgram.c"
+#line 3493 "awkgram.c"
     break;
 
   case 108: /* opt_exp: exp  */
-#line 1520 "awkgram.y"
+#line 1526 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3552 "awkgram.c"
+#line 3499 "awkgram.c"
     break;
 
   case 109: /* opt_expression_list: %empty  */
-#line 1525 "awkgram.y"
+#line 1531 "awkgram.y"
           { yyval = NULL; }
-#line 3558 "awkgram.c"
+#line 3505 "awkgram.c"
     break;
 
   case 110: /* opt_expression_list: expression_list  */
-#line 1527 "awkgram.y"
+#line 1533 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3564 "awkgram.c"
+#line 3511 "awkgram.c"
     break;
 
   case 111: /* expression_list: exp  */
-#line 1532 "awkgram.y"
+#line 1538 "awkgram.y"
           {	yyval = mk_expression_list(NULL, yyvsp[0]); }
-#line 3570 "awkgram.c"
+#line 3517 "awkgram.c"
     break;
 
   case 112: /* expression_list: expression_list comma exp  */
-#line 1534 "awkgram.y"
+#line 1540 "awkgram.y"
           {
 		if (yyvsp[-1] != NULL)
 			yyvsp[-2]->lasti->comment = yyvsp[-1];
 		yyval = mk_expression_list(yyvsp[-2], yyvsp[0]);
 		yyerrok;
 	  }
-#line 3581 "awkgram.c"
+#line 3528 "awkgram.c"
     break;
 
   case 113: /* expression_list: error  */
-#line 1541 "awkgram.y"
+#line 1547 "awkgram.y"
           { yyval = NULL; }
-#line 3587 "awkgram.c"
+#line 3534 "awkgram.c"
     break;
 
   case 114: /* expression_list: expression_list error  */
-#line 1543 "awkgram.y"
+#line 1549 "awkgram.y"
           {
 		/*
 		 * Returning the expression list instead of NULL lets
@@ -3595,66 +3542,66 @@ regular_print:
 		 */
 		yyval = yyvsp[-1];
 	  }
-#line 3599 "awkgram.c"
+#line 3546 "awkgram.c"
     break;
 
   case 115: /* expression_list: expression_list error exp  */
-#line 1551 "awkgram.y"
+#line 1557 "awkgram.y"
           {
 		/* Ditto */
 		yyval = mk_expression_list(yyvsp[-2], yyvsp[0]);
 	  }
-#line 3608 "awkgram.c"
+#line 3555 "awkgram.c"
     break;
 
   case 116: /* expression_list: expression_list comma error  */
-#line 1556 "awkgram.y"
+#line 1562 "awkgram.y"
           {
 		/* Ditto */
 		if (yyvsp[-1] != NULL)
 			yyvsp[-2]->lasti->comment = yyvsp[-1];
 		yyval = yyvsp[-2];
 	  }
-#line 3619 "awkgram.c"
+#line 3566 "awkgram.c"
     break;
 
   case 117: /* opt_fcall_expression_list: %empty  */
-#line 1566 "awkgram.y"
+#line 1572 "awkgram.y"
           { yyval = NULL; }
-#line 3625 "awkgram.c"
+#line 3572 "awkgram.c"
     break;
 
   case 118: /* opt_fcall_expression_list: fcall_expression_list  */
-#line 1568 "awkgram.y"
+#line 1574 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3631 "awkgram.c"
+#line 3578 "awkgram.c"
     break;
 
   case 119: /* fcall_expression_list: fcall_exp  */
-#line 1573 "awkgram.y"
+#line 1579 "awkgram.y"
           {	yyval = mk_expression_list(NULL, yyvsp[0]); }
-#line 3637 "awkgram.c"
+#line 3584 "awkgram.c"
     break;
 
   case 120: /* fcall_expression_list: fcall_expression_list comma fcall_exp  */
-#line 1575 "awkgram.y"
+#line 1581 "awkgram.y"
           {
 		if (yyvsp[-1] != NULL)
 			yyvsp[-2]->lasti->comment = yyvsp[-1];
 		yyval = mk_expression_list(yyvsp[-2], yyvsp[0]);
 		yyerrok;
 	  }
-#line 3648 "awkgram.c"
+#line 3595 "awkgram.c"
     break;
 
   case 121: /* fcall_expression_list: error  */
-#line 1582 "awkgram.y"
+#line 1588 "awkgram.y"
           { yyval = NULL; }
-#line 3654 "awkgram.c"
+#line 3601 "awkgram.c"
     break;
 
   case 122: /* fcall_expression_list: fcall_expression_list error  */
-#line 1584 "awkgram.y"
+#line 1590 "awkgram.y"
           {
 		/*
 		 * Returning the expression list instead of NULL lets
@@ -3662,86 +3609,86 @@ regular_print:
 		 */
 		yyval = yyvsp[-1];
 	  }
-#line 3666 "awkgram.c"
+#line 3613 "awkgram.c"
     break;
 
   case 123: /* fcall_expression_list: fcall_expression_list error fcall_exp  */
-#line 1592 "awkgram.y"
+#line 1598 "awkgram.y"
           {
 		/* Ditto */
 		yyval = mk_expression_list(yyvsp[-2], yyvsp[0]);
 	  }
-#line 3675 "awkgram.c"
+#line 3622 "awkgram.c"
     break;
 
   case 124: /* fcall_expression_list: fcall_expression_list comma error  */
-#line 1597 "awkgram.y"
+#line 1603 "awkgram.y"
           {
 		/* Ditto */
 		if (yyvsp[-1] != NULL)
 			yyvsp[-2]->comment = yyvsp[-1];
 		yyval = yyvsp[-2];
 	  }
-#line 3686 "awkgram.c"
+#line 3633 "awkgram.c"
     break;
 
   case 125: /* fcall_exp: exp  */
-#line 1606 "awkgram.y"
+#line 1612 "awkgram.y"
               { yyval = yyvsp[0]; }
-#line 3692 "awkgram.c"
+#line 3639 "awkgram.c"
     break;
 
   case 126: /* fcall_exp: typed_regexp  */
-#line 1607 "awkgram.y"
+#line 1613 "awkgram.y"
                        { yyval = list_create(yyvsp[0]); }
-#line 3698 "awkgram.c"
+#line 3645 "awkgram.c"
     break;
 
   case 127: /* opt_fcall_exp: %empty  */
-#line 1612 "awkgram.y"
+#line 1618 "awkgram.y"
           { yyval = NULL; }
-#line 3704 "awkgram.c"
+#line 3651 "awkgram.c"
     break;
 
   case 128: /* opt_fcall_exp: fcall_exp  */
-#line 1613 "awkgram.y"
+#line 1619 "awkgram.y"
                     { yyval = yyvsp[0]; }
-#line 3710 "awkgram.c"
+#line 3657 "awkgram.c"
     break;
 
   case 129: /* exp: variable assign_operator exp  */
-#line 1619 "awkgram.y"
+#line 1625 "awkgram.y"
           {
 		if (do_lint && yyvsp[0]->lasti->opcode == Op_match_rec)
 			lintwarn_ln(yyvsp[-1]->source_line,
 				_("regular expression on right of assignment"));
 		yyval = mk_assignment(yyvsp[-2], yyvsp[0], yyvsp[-1]);
 	  }
-#line 3721 "awkgram.c"
+#line 3668 "awkgram.c"
     break;
 
   case 130: /* exp: variable ASSIGN typed_regexp  */
-#line 1626 "awkgram.y"
+#line 1632 "awkgram.y"
           {
 		yyval = mk_assignment(yyvsp[-2], list_create(yyvsp[0]), yyvsp[-1]);
 	  }
-#line 3729 "awkgram.c"
+#line 3676 "awkgram.c"
     break;
 
   case 131: /* exp: exp LEX_AND exp  */
-#line 1630 "awkgram.y"
+#line 1636 "awkgram.y"
           {	yyval = mk_boolean(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3735 "awkgram.c"
+#line 3682 "awkgram.c"
     break;
 
   case 132: /* exp: exp LEX_OR exp  */
-#line 1632 "awkgram.y"
+#line 1638 "awkgram.y"
           {	yyval = mk_boolean(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3741 "awkgram.c"
+#line 3688 "awkgram.c"
     break;
 
   case 133: /* exp: exp MATCHOP typed_regexp  */
-#line 1634 "awkgram.y"
+#line 1640 "awkgram.y"
           {
 		if (yyvsp[-2]->lasti->opcode == Op_match_rec)
 			warning_ln(yyvsp[-1]->source_line,
@@ -3754,11 +3701,11 @@ regular_print:
 		bcfree(yyvsp[0]);
 		yyval = list_append(yyvsp[-2], yyvsp[-1]);
 	  }
-#line 3758 "awkgram.c"
+#line 3705 "awkgram.c"
     break;
 
   case 134: /* exp: exp MATCHOP exp  */
-#line 1647 "awkgram.y"
+#line 1653 "awkgram.y"
           {
 		if (yyvsp[-2]->lasti->opcode == Op_match_rec)
 			warning_ln(yyvsp[-1]->source_line,
@@ -3775,102 +3722,102 @@ regular_print:
 			yyval = list_append(list_merge(yyvsp[-2], yyvsp[0]), yyvsp[-1]);
 		}
 	  }
-#line 3779 "awkgram.c"
+#line 3726 "awkgram.c"
     break;
 
   case 135: /* exp: exp LEX_IN simple_variable  */
-#line 1664 "awkgram.y"
+#line 1670 "awkgram.y"
           {
 		yyvsp[0]->nexti->opcode = Op_push_array;
 		yyvsp[-1]->opcode = Op_in_array;
 		yyvsp[-1]->expr_count = 1;
 		yyval = list_append(list_merge(yyvsp[-2], yyvsp[0]), yyvsp[-1]);
 	  }
-#line 3790 "awkgram.c"
+#line 3737 "awkgram.c"
     break;
 
   case 136: /* exp: exp a_relop exp  */
-#line 1671 "awkgram.y"
+#line 1677 "awkgram.y"
           {
 		if (do_lint && yyvsp[0]->lasti->opcode == Op_match_rec)
 			lintwarn_ln(yyvsp[-1]->source_line,
 				_("regular expression on right of comparison"));
 		yyval = list_append(list_merge(yyvsp[-2], yyvsp[0]), yyvsp[-1]);
 	  }
-#line 3801 "awkgram.c"
+#line 3748 "awkgram.c"
     break;
 
   case 137: /* exp: exp '?' exp ':' exp  */
-#line 1678 "awkgram.y"
+#line 1684 "awkgram.y"
           { yyval = mk_condition(yyvsp[-4], yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0]); }
-#line 3807 "awkgram.c"
+#line 3754 "awkgram.c"
     break;
 
   case 138: /* exp: common_exp  */
-#line 1680 "awkgram.y"
+#line 1686 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3813 "awkgram.c"
+#line 3760 "awkgram.c"
     break;
 
   case 139: /* assign_operator: ASSIGN  */
-#line 1685 "awkgram.y"
+#line 1691 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3819 "awkgram.c"
+#line 3766 "awkgram.c"
     break;
 
   case 140: /* assign_operator: ASSIGNOP  */
-#line 1687 "awkgram.y"
+#line 1693 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3825 "awkgram.c"
+#line 3772 "awkgram.c"
     break;
 
   case 141: /* assign_operator: SLASH_BEFORE_EQUAL ASSIGN  */
-#line 1689 "awkgram.y"
+#line 1695 "awkgram.y"
           {
 		yyvsp[0]->opcode = Op_assign_quotient;
 		yyval = yyvsp[0];
 	  }
-#line 3834 "awkgram.c"
+#line 3781 "awkgram.c"
     break;
 
   case 142: /* relop_or_less: RELOP  */
-#line 1697 "awkgram.y"
+#line 1703 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3840 "awkgram.c"
+#line 3787 "awkgram.c"
     break;
 
   case 143: /* relop_or_less: '<'  */
-#line 1699 "awkgram.y"
+#line 1705 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3846 "awkgram.c"
+#line 3793 "awkgram.c"
     break;
 
   case 144: /* a_relop: relop_or_less  */
-#line 1704 "awkgram.y"
+#line 1710 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3852 "awkgram.c"
+#line 3799 "awkgram.c"
     break;
 
   case 145: /* a_relop: '>'  */
-#line 1706 "awkgram.y"
+#line 1712 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3858 "awkgram.c"
+#line 3805 "awkgram.c"
     break;
 
   case 146: /* common_exp: simp_exp  */
-#line 1711 "awkgram.y"
+#line 1717 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3864 "awkgram.c"
+#line 3811 "awkgram.c"
     break;
 
   case 147: /* common_exp: simp_exp_nc  */
-#line 1713 "awkgram.y"
+#line 1719 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 3870 "awkgram.c"
+#line 3817 "awkgram.c"
     break;
 
   case 148: /* common_exp: common_exp simp_exp  */
-#line 1715 "awkgram.y"
+#line 1721 "awkgram.y"
           {
 		int count = 2;
 		bool is_simple_var = false;
@@ -3924,47 +3871,47 @@ regular_print:
 				max_args = count;
 		}
 	  }
-#line 3928 "awkgram.c"
+#line 3875 "awkgram.c"
     break;
 
   case 150: /* simp_exp: simp_exp '^' simp_exp  */
-#line 1774 "awkgram.y"
+#line 1780 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3934 "awkgram.c"
+#line 3881 "awkgram.c"
     break;
 
   case 151: /* simp_exp: simp_exp '*' simp_exp  */
-#line 1776 "awkgram.y"
+#line 1782 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3940 "awkgram.c"
+#line 3887 "awkgram.c"
     break;
 
   case 152: /* simp_exp: simp_exp '/' simp_exp  */
-#line 1778 "awkgram.y"
+#line 1784 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3946 "awkgram.c"
+#line 3893 "awkgram.c"
     break;
 
   case 153: /* simp_exp: simp_exp '%' simp_exp  */
-#line 1780 "awkgram.y"
+#line 1786 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3952 "awkgram.c"
+#line 3899 "awkgram.c"
     break;
 
   case 154: /* simp_exp: simp_exp '+' simp_exp  */
-#line 1782 "awkgram.y"
+#line 1788 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3958 "awkgram.c"
+#line 3905 "awkgram.c"
     break;
 
   case 155: /* simp_exp: simp_exp '-' simp_exp  */
-#line 1784 "awkgram.y"
+#line 1790 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 3964 "awkgram.c"
+#line 3911 "awkgram.c"
     break;
 
   case 156: /* simp_exp: LEX_GETLINE opt_variable input_redir  */
-#line 1786 "awkgram.y"
+#line 1792 "awkgram.y"
           {
 		/*
 		 * In BEGINFILE/ENDFILE, allow `getline [var] < file'
@@ -3978,29 +3925,29 @@ regular_print:
 				_("non-redirected `getline' undefined inside END action"));
 		yyval = mk_getline(yyvsp[-2], yyvsp[-1], yyvsp[0], redirect_input);
 	  }
-#line 3982 "awkgram.c"
+#line 3929 "awkgram.c"
     break;
 
   case 157: /* simp_exp: variable INCREMENT  */
-#line 1800 "awkgram.y"
+#line 1806 "awkgram.y"
           {
 		yyvsp[0]->opcode = Op_postincrement;
 		yyval = mk_assignment(yyvsp[-1], NULL, yyvsp[0]);
 	  }
-#line 3991 "awkgram.c"
+#line 3938 "awkgram.c"
     break;
 
   case 158: /* simp_exp: variable DECREMENT  */
-#line 1805 "awkgram.y"
+#line 1811 "awkgram.y"
           {
 		yyvsp[0]->opcode = Op_postdecrement;
 		yyval = mk_assignment(yyvsp[-1], NULL, yyvsp[0]);
 	  }
-#line 4000 "awkgram.c"
+#line 3947 "awkgram.c"
     break;
 
   case 159: /* simp_exp: '(' expression_list r_paren LEX_IN simple_variable  */
-#line 1810 "awkgram.y"
+#line 1816 "awkgram.y"
           {
 		yyvsp[0]->nexti->opcode = Op_push_array;
 		yyvsp[-1]->opcode = Op_in_array;
@@ -4014,64 +3961,64 @@ regular_print:
 			yyval = list_append(list_merge(t, yyvsp[0]), yyvsp[-1]);
 		}
 	  }
-#line 4018 "awkgram.c"
+#line 3965 "awkgram.c"
     break;
 
   case 160: /* simp_exp_nc: common_exp IO_IN LEX_GETLINE opt_variable  */
-#line 1829 "awkgram.y"
+#line 1835 "awkgram.y"
                 {
 		  yyval = mk_getline(yyvsp[-1], yyvsp[0], yyvsp[-3], yyvsp[-2]->redir_type);
 		  bcfree(yyvsp[-2]);
 		}
-#line 4027 "awkgram.c"
+#line 3974 "awkgram.c"
     break;
 
   case 161: /* simp_exp_nc: simp_exp_nc '^' simp_exp  */
-#line 1835 "awkgram.y"
+#line 1841 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 4033 "awkgram.c"
+#line 3980 "awkgram.c"
     break;
 
   case 162: /* simp_exp_nc: simp_exp_nc '*' simp_exp  */
-#line 1837 "awkgram.y"
+#line 1843 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 4039 "awkgram.c"
+#line 3986 "awkgram.c"
     break;
 
   case 163: /* simp_exp_nc: simp_exp_nc '/' simp_exp  */
-#line 1839 "awkgram.y"
+#line 1845 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 4045 "awkgram.c"
+#line 3992 "awkgram.c"
     break;
 
   case 164: /* simp_exp_nc: simp_exp_nc '%' simp_exp  */
-#line 1841 "awkgram.y"
+#line 1847 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 4051 "awkgram.c"
+#line 3998 "awkgram.c"
     break;
 
   case 165: /* simp_exp_nc: simp_exp_nc '+' simp_exp  */
-#line 1843 "awkgram.y"
+#line 1849 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 4057 "awkgram.c"
+#line 4004 "awkgram.c"
     break;
 
   case 166: /* simp_exp_nc: simp_exp_nc '-' simp_exp  */
-#line 1845 "awkgram.y"
+#line 1851 "awkgram.y"
           { yyval = mk_binary(yyvsp[-2], yyvsp[0], yyvsp[-1]); }
-#line 4063 "awkgram.c"
+#line 4010 "awkgram.c"
     break;
 
   case 167: /* non_post_simp_exp: regexp  */
-#line 1850 "awkgram.y"
+#line 1856 "awkgram.y"
           {
 		yyval = list_create(yyvsp[0]);
 	  }
-#line 4071 "awkgram.c"
+#line 4018 "awkgram.c"
     break;
 
   case 168: /* non_post_simp_exp: '!' simp_exp  */
-#line 1854 "awkgram.y"
+#line 1860 "awkgram.y"
           {
 		if (yyvsp[0]->opcode == Op_match_rec) {
 			yyvsp[0]->opcode = Op_nomatch;
@@ -4103,11 +4050,11 @@ regular_print:
 			}
 		}
 	   }
-#line 4107 "awkgram.c"
+#line 4054 "awkgram.c"
     break;
 
   case 169: /* non_post_simp_exp: '(' exp r_paren  */
-#line 1886 "awkgram.y"
+#line 1892 "awkgram.y"
           {
 		// Always include. Allows us to lint warn on
 		// print "foo" > "bar" 1
@@ -4115,31 +4062,31 @@ regular_print:
 		// print "foo" > ("bar" 1)
 		yyval = list_append(yyvsp[-1], bcalloc(Op_parens, 1, sourceline));
 	  }
-#line 4119 "awkgram.c"
+#line 4066 "awkgram.c"
     break;
 
   case 170: /* non_post_simp_exp: LEX_BUILTIN '(' opt_fcall_expression_list r_paren  */
-#line 1894 "awkgram.y"
+#line 1900 "awkgram.y"
           {
 		yyval = snode(yyvsp[-1], yyvsp[-3]);
 		if (yyval == NULL)
 			YYABORT;
 	  }
-#line 4129 "awkgram.c"
+#line 4076 "awkgram.c"
     break;
 
   case 171: /* non_post_simp_exp: LEX_LENGTH '(' opt_fcall_expression_list r_paren  */
-#line 1900 "awkgram.y"
+#line 1906 "awkgram.y"
           {
 		yyval = snode(yyvsp[-1], yyvsp[-3]);
 		if (yyval == NULL)
 			YYABORT;
 	  }
-#line 4139 "awkgram.c"
+#line 4086 "awkgram.c"
     break;
 
   case 172: /* non_post_simp_exp: LEX_LENGTH  */
-#line 1906 "awkgram.y"
+#line 1912 "awkgram.y"
           {
 		static bool warned = false;
 
@@ -4152,45 +4099,45 @@ regular_print:
 		if (yyval == NULL)
 			YYABORT;
 	  }
-#line 4156 "awkgram.c"
+#line 4103 "awkgram.c"
     break;
 
   case 175: /* non_post_simp_exp: INCREMENT variable  */
-#line 1921 "awkgram.y"
+#line 1927 "awkgram.y"
           {
 		yyvsp[-1]->opcode = Op_preincrement;
 		yyval = mk_assignment(yyvsp[0], NULL, yyvsp[-1]);
 	  }
-#line 4165 "awkgram.c"
+#line 4112 "awkgram.c"
     break;
 
   case 176: /* non_post_simp_exp: DECREMENT variable  */
-#line 1926 "awkgram.y"
+#line 1932 "awkgram.y"
           {
 		yyvsp[-1]->opcode = Op_predecrement;
 		yyval = mk_assignment(yyvsp[0], NULL, yyvsp[-1]);
 	  }
-#line 4174 "awkgram.c"
+#line 4121 "awkgram.c"
     break;
 
   case 177: /* non_post_simp_exp: YNUMBER  */
-#line 1931 "awkgram.y"
+#line 1937 "awkgram.y"
           {
 		yyval = list_create(yyvsp[0]);
 	  }
-#line 4182 "awkgram.c"
+#line 4129 "awkgram.c"
     break;
 
   case 178: /* non_post_simp_exp: YSTRING  */
-#line 1935 "awkgram.y"
+#line 1941 "awkgram.y"
           {
 		yyval = list_create(yyvsp[0]);
 	  }
-#line 4190 "awkgram.c"
+#line 4137 "awkgram.c"
     break;
 
   case 179: /* non_post_simp_exp: '-' simp_exp  */
-#line 1939 "awkgram.y"
+#line 1945 "awkgram.y"
           {
 		if (yyvsp[0]->lasti->opcode == Op_push_i
 			&& (yyvsp[0]->lasti->memory->flags & STRING) == 0
@@ -4205,11 +4152,11 @@ regular_print:
 			yyval = list_append(yyvsp[0], yyvsp[-1]);
 		}
 	  }
-#line 4209 "awkgram.c"
+#line 4156 "awkgram.c"
     break;
 
   case 180: /* non_post_simp_exp: '+' simp_exp  */
-#line 1954 "awkgram.y"
+#line 1960 "awkgram.y"
           {
 		if (yyvsp[0]->lasti->opcode == Op_push_i
 			&& (yyvsp[0]->lasti->memory->flags & STRING) == 0
@@ -4227,20 +4174,20 @@ regular_print:
 			yyval = list_append(yyvsp[0], yyvsp[-1]);
 		}
 	  }
-#line 4231 "awkgram.c"
+#line 4178 "awkgram.c"
     break;
 
   case 181: /* func_call: direct_func_call  */
-#line 1975 "awkgram.y"
+#line 1981 "awkgram.y"
           {
 		func_use(yyvsp[0]->lasti->func_name, FUNC_USE);
 		yyval = yyvsp[0];
 	  }
-#line 4240 "awkgram.c"
+#line 4187 "awkgram.c"
     break;
 
   case 182: /* func_call: '@' direct_func_call  */
-#line 1980 "awkgram.y"
+#line 1986 "awkgram.y"
           {
 		/* indirect function call */
 		INSTRUCTION *f, *t;
@@ -4274,11 +4221,11 @@ regular_print:
 		yyval = list_prepend(yyvsp[0], t);
 		at_seen--;
 	  }
-#line 4278 "awkgram.c"
+#line 4225 "awkgram.c"
     break;
 
   case 183: /* direct_func_call: FUNC_CALL '(' opt_fcall_expression_list r_paren  */
-#line 2017 "awkgram.y"
+#line 2023 "awkgram.y"
           {
 		NODE *n;
 		char *name = yyvsp[-3]->func_name;
@@ -4311,49 +4258,49 @@ regular_print:
 			yyval = list_append(t, yyvsp[-3]);
 		}
 	  }
-#line 4315 "awkgram.c"
+#line 4262 "awkgram.c"
     break;
 
   case 184: /* opt_variable: %empty  */
-#line 2053 "awkgram.y"
+#line 2059 "awkgram.y"
           { yyval = NULL; }
-#line 4321 "awkgram.c"
+#line 4268 "awkgram.c"
     break;
 
   case 185: /* opt_variable: variable  */
-#line 2055 "awkgram.y"
+#line 2061 "awkgram.y"
           { yyval = yyvsp[0]; }
-#line 4327 "awkgram.c"
+#line 4274 "awkgram.c"
     break;
 
   case 186: /* delete_subscript_list: %empty  */
-#line 2060 "awkgram.y"
+#line 2066 "awkgram.y"
           { yyval = NULL; }
-#line 4333 "awkgram.c"
+#line 4280 "awkgram.c"
     break;
 
   case 187: /* delete_subscript_list: delete_subscript SUBSCRIPT  */
-#line 2062 "awkgram.y"
+#line 2068 "awkgram.y"
           { yyval = yyvsp[-1]; }
-#line 4339 "awkgram.c"
+#line 4286 "awkgram.c"
     break;
 
   case 188: /* delete_subscript: delete_exp_list  */
-#line 2067 "awkgram.y"
+#line 2073 "awkgram.y"
           {	yyval = yyvsp[0]; }
-#line 4345 "awkgram.c"
+#line 4292 "awkgram.c"
     break;
 
   case 189: /* delete_subscript: delete_subscript delete_exp_list  */
-#line 2069 "awkgram.y"
+#line 2075 "awkgram.y"
           {
 		yyval = list_merge(yyvsp[-1], yyvsp[0]);
 	  }
-#line 4353 "awkgram.c"
+#line 4300 "awkgram.c"
     break;
 
   case 190: /* delete_exp_list: bracketed_exp_list  */
-#line 2076 "awkgram.y"
+#line 2082 "awkgram.y"
           {
 		INSTRUCTION *ip = yyvsp[0]->lasti;
 		int count = ip->sub_count;	/* # of SUBSEP-seperated expressions */
@@ -4367,11 +4314,11 @@ regular_print:
 		sub_counter++;	/* count # of dimensions */
 		yyval = yyvsp[0];
 	  }
-#line 4371 "awkgram.c"
+#line 4318 "awkgram.c"
     break;
 
   case 191: /* bracketed_exp_list: '[' expression_list ']'  */
-#line 2093 "awkgram.y"
+#line 2099 "awkgram.y"
           {
 		INSTRUCTION *t = yyvsp[-1];
 		if (yyvsp[-1] == NULL) {
@@ -4385,41 +4332,41 @@ regular_print:
 			yyvsp[0]->sub_count = count_expressions(&t, false);
 		yyval = list_append(t, yyvsp[0]);
 	  }
-#line 4389 "awkgram.c"
+#line 4336 "awkgram.c"
     break;
 
   case 192: /* subscript: bracketed_exp_list  */
-#line 2110 "awkgram.y"
+#line 2116 "awkgram.y"
           {	yyval = yyvsp[0]; }
-#line 4395 "awkgram.c"
+#line 4342 "awkgram.c"
     break;
 
   case 193: /* subscript: subscript bracketed_exp_list  */
-#line 2112 "awkgram.y"
+#line 2118 "awkgram.y"
           {
 		yyval = list_merge(yyvsp[-1], yyvsp[0]);
 	  }
-#line 4403 "awkgram.c"
+#line 4350 "awkgram.c"
     break;
 
   case 194: /* subscript_list: subscript SUBSCRIPT  */
-#line 2119 "awkgram.y"
+#line 2125 "awkgram.y"
           { yyval = yyvsp[-1]; }
-#line 4409 "awkgram.c"
+#line 4356 "awkgram.c"
     break;
 
   case 195: /* simple_variable: NAME  */
-#line 2124 "awkgram.y"
+#line 2130 "awkgram.y"
           {
 		yyvsp[0]->opcode = Op_push;
 		yyvsp[0]->memory = variable(yyvsp[0]->source_line, yyvsp[0]->lextok, Node_var_new);
 		yyval = list_create(yyvsp[0]);
 	  }
-#line 4419 "awkgram.c"
+#line 4366 "awkgram.c"
     break;
 
   case 196: /* simple_variable: NAME subscript_list  */
-#line 2130 "awkgram.y"
+#line 2136 "awkgram.y"
           {
 		char *arr = yyvsp[-1]->lextok;
 
@@ -4428,11 +4375,11 @@ regular_print:
 		yyvsp[-1]->opcode = Op_push_array;
 		yyval = list_prepend(yyvsp[0], yyvsp[-1]);
 	  }
-#line 4432 "awkgram.c"
+#line 4379 "awkgram.c"
     break;
 
   case 197: /* variable: simple_variable  */
-#line 2142 "awkgram.y"
+#line 2148 "awkgram.y"
           {
 		INSTRUCTION *ip = yyvsp[0]->nexti;
 		if (ip->opcode == Op_push
@@ -4444,85 +4391,85 @@ regular_print:
 		} else
 			yyval = yyvsp[0];
 	  }
-#line 4448 "awkgram.c"
+#line 4395 "awkgram.c"
     break;
 
   case 198: /* variable: '$' non_post_simp_exp opt_incdec  */
-#line 2154 "awkgram.y"
+#line 2160 "awkgram.y"
           {
 		yyval = list_append(yyvsp[-1], yyvsp[-2]);
 		if (yyvsp[0] != NULL)
 			mk_assignment(yyvsp[-1], NULL, yyvsp[0]);
 	  }
-#line 4458 "awkgram.c"
+#line 4405 "awkgram.c"
     break;
 
   case 199: /* opt_incdec: INCREMENT  */
-#line 2163 "awkgram.y"
+#line 2169 "awkgram.y"
           {
 		yyvsp[0]->opcode = Op_postincrement;
 	  }
-#line 4466 "awkgram.c"
+#line 4413 "awkgram.c"
     break;
 
   case 200: /* opt_incdec: DECREMENT  */
-#line 2167 "awkgram.y"
+#line 2173 "awkgram.y"
           {
 		yyvsp[0]->opcode = Op_postdecrement;
 	  }
-#line 4474 "awkgram.c"
+#line 4421 "awkgram.c"
     break;
 
   case 201: /* opt_incdec: %empty  */
-#line 2171 "awkgram.y"
+#line 2177 "awkgram.y"
           { yyval = NULL; }
-#line 4480 "awkgram.c"
+#line 4427 "awkgram.c"
     break;
 
   case 202: /* l_brace: '{' opt_nls  */
-#line 2175 "awkgram.y"
+#line 2181 "awkgram.y"
                       { yyval = yyvsp[0]; }
-#line 4486 "awkgram.c"
+#line 4433 "awkgram.c"
     break;
 
   case 203: /* r_brace: '}' opt_nls  */
-#line 2179 "awkgram.y"
+#line 2185 "awkgram.y"
                         { yyval = yyvsp[0]; yyerrok; }
-#line 4492 "awkgram.c"
+#line 4439 "awkgram.c"
     break;
 
   case 204: /* r_paren: ')'  */
-#line 2183 "awkgram.y"
+#line 2189 "awkgram.y"
               { yyerrok; }
-#line 4498 "awkgram.c"
+#line 4445 "awkgram.c"
     break;
 
   case 205: /* opt_semi: %empty  */
-#line 2188 "awkgram.y"
+#line 2194 "awkgram.y"
           { yyval = NULL; }
-#line 4504 "awkgram.c"
+#line 4451 "awkgram.c"
     break;
 
   case 207: /* semi: ';'  */
-#line 2193 "awkgram.y"
+#line 2199 "awkgram.y"
                 { yyerrok; }
-#line 4510 "awkgram.c"
+#line 4457 "awkgram.c"
     break;
 
   case 208: /* colon: ':'  */
-#line 2197 "awkgram.y"
+#line 2203 "awkgram.y"
                 { yyval = yyvsp[0]; yyerrok; }
-#line 4516 "awkgram.c"
+#line 4463 "awkgram.c"
     break;
 
   case 209: /* comma: ',' opt_nls  */
-#line 2201 "awkgram.y"
+#line 2207 "awkgram.y"
                         { yyval = yyvsp[0]; yyerrok; }
-#line 4522 "awkgram.c"
+#line 4469 "awkgram.c"
     break;
 
 
-#line 4526 "awkgram.c"
+#line 4473 "awkgram.c"
 
       default: break;
     }
@@ -4715,7 +4662,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 2203 "awkgram.y"
+#line 2209 "awkgram.y"
 
 
 struct token {
@@ -5293,6 +5240,15 @@ parse_program(INSTRUCTION **pcode, bool from_eval)
 	if (ret == 0)	/* avoid spurious warning if parser aborted with YYABORT */
 		check_funcs();
 
+	if (ret == 0 && errcount == 0 && do_optimize && ! do_debug
+			&& in_main_context())
+		optimize_program(*pcode);
+
+	if (func_defs != NULL)
+		efree(func_defs);
+	func_defs = NULL;
+	func_defs_count = func_defs_size = 0;
+
 	if (do_posix && ! check_param_names())
 		errcount++;
 
@@ -7406,6 +7362,7 @@ dump_vars(const char *fname)
 	vars = variable_list();
 	print_vars(vars, fprintf, fp);
 	efree(vars);
+	print_field_projection(fp);
 	if (fp != stdout && fp != stderr && fclose(fp) != 0)
 		warning(_("%s: close failed: %s"), fname, strerror(errno));
 }
@@ -7548,6 +7505,16 @@ install_function(char *fname, INSTRUCTION *fi, INSTRUCTION *plist)
 	f->param_cnt = pcount;
 	f->code_ptr = fi;
 	f->fparms = NULL;
+
+	if (func_defs_count == func_defs_size) {
+		func_defs_size = (func_defs_size == 0) ? 64 : 2 * func_defs_size;
+		if (func_defs == NULL)
+			emalloc(func_defs, NODE **, func_defs_size * sizeof(NODE *));
+		else
+			erealloc(func_defs, NODE **, func_defs_size * sizeof(NODE *));
+	}
+	func_defs[func_defs_count++] = f;
+
 	if (pcount > 0) {
 		char **pnames;
 		pnames = check_params(fname, pcount, plist);	/* frees plist */
@@ -7622,7 +7589,35 @@ static struct fdesc {
 	short defined;
 	short extension;
 	struct fdesc *next;
-} *ftable[HASHSIZE];
+} **ftable;
+
+static unsigned long ftable_size;	/* HASHSIZE, more for large programs */
+static unsigned long ftable_count;
+
+/* grow_ftable --- make the function table larger, or allocate it */
+
+static void
+grow_ftable()
+{
+	struct fdesc **old = ftable;
+	unsigned long oldsize = ftable_size;
+	struct fdesc *fp, *next;
+	unsigned long i, ind;
+
+	ftable_size = (old == NULL) ? HASHSIZE : 4 * oldsize + 1;
+	ezalloc(ftable, struct fdesc **, ftable_size * sizeof(struct fdesc *));
+
+	for (i = 0; i < oldsize; i++) {
+		for (fp = old[i]; fp != NULL; fp = next) {
+			next = fp->next;
+			ind = hash(fp->name, strlen(fp->name), ftable_size, NULL);
+			fp->next = ftable[ind];
+			ftable[ind] = fp;
+		}
+	}
+	if (old != NULL)
+		efree(old);
+}
 
 /* func_use --- track uses and definitions of functions */
 
@@ -7633,8 +7628,11 @@ func_use(const char *name, enum defref how)
 	int len;
 	int ind;
 
+	if (ftable == NULL)
+		grow_ftable();
+
 	len = strlen(name);
-	ind = hash(name, len, HASHSIZE, NULL);
+	ind = hash(name, len, ftable_size, NULL);
 
 	for (fp = ftable[ind]; fp != NULL; fp = fp->next)
 		if (strcmp(fp->name, name) == 0)
@@ -7642,11 +7640,18 @@ func_use(const char *name, enum defref how)
 
 	/* not in the table, fall through to allocate a new one */
 
+	if (ftable_count >= 2 * ftable_size) {
+		/* keep the chains short for large libraries */
+		grow_ftable();
+		ind = hash(name, len, ftable_size, NULL);
+	}
+
 	ezalloc(fp, struct fdesc *, sizeof(struct fdesc));
 	emalloc(fp->name, char *, len + 1);
 	strcpy(fp->name, name);
 	fp->next = ftable[ind];
 	ftable[ind] = fp;
+	ftable_count++;
 
 update_value:
 	if (how == FUNC_DEFINE)
@@ -7672,12 +7677,15 @@ static void
 check_funcs()
 {
 	struct fdesc *fp, *next;
-	int i;
+	unsigned long i;
+
+	if (ftable == NULL)
+		return;
 
 	if (! in_main_context())
 		goto free_mem;
 
-	for (i = 0; i < HASHSIZE; i++) {
+	for (i = 0; i < ftable_size; i++) {
 		for (fp = ftable[i]; fp != NULL; fp = fp->next) {
 			if (do_lint && ! fp->extension) {
 				/*
@@ -7698,14 +7706,16 @@ check_funcs()
 
 free_mem:
 	/* now let's free all the memory */
-	for (i = 0; i < HASHSIZE; i++) {
+	for (i = 0; i < ftable_size; i++) {
 		for (fp = ftable[i]; fp != NULL; fp = next) {
 			next = fp->next;
 			efree(fp->name);
 			efree(fp);
 		}
-		ftable[i] = NULL;
 	}
+	efree(ftable);
+	ftable = NULL;
+	ftable_size = ftable_count = 0;
 }
 
 /* param_sanity --- look for parameters that are regexp constants */
@@ -8551,111 +8561,1624 @@ optimize_assignment(INSTRUCTION *exp)
 }
 
 
-/* mk_getline --- make instructions for getline */
+/*
+ * Function inlining.
+ *
+ * A call to a small function whose body only computes a value from its
+ * (scalar) parameters, constants and global variables is followed by a
+ * private copy of that body.  The call instruction becomes
+ * Op_func_call_inline; at run time it checks that all the arguments are
+ * scalar values and if so simply falls into the copy, which picks up
+ * the arguments straight from the runtime stack (Op_push_stack) and
+ * leaves the return value in their place (Op_inline_return).  If an
+ * argument is an untyped variable or an array, a real call is made
+ * instead, and the function returns to the instruction after the copy.
+ *
+ * Only straight-line code and forward branches (if-else, ?:, && and ||)
+ * are accepted, with no assignments and no calls other than to a
+ * handful of builtins without side effects.
+ */
 
-static INSTRUCTION *
-mk_getline(INSTRUCTION *op, INSTRUCTION *var, INSTRUCTION *redir, int redirtype)
+#define INLINE_MAX_INSNS	30
+
+/* pure_builtin --- true if the builtin has no side effects */
+
+static bool
+pure_builtin(NODE *(*fptr)(int))
 {
-	INSTRUCTION *ip;
-	INSTRUCTION *tp;
-	INSTRUCTION *asgn = NULL;
+	static NODE *(*const pure[])(int) = {
+		do_length, do_substr, do_index, do_tolower, do_toupper,
+		do_int, do_sqrt, do_exp, do_log, do_sin, do_cos, do_atan2,
+		do_sprintf, do_strtonum,
+		do_and, do_or, do_xor, do_compl, do_lshift, do_rshift,
+	};
+	size_t i;
+
+	for (i = 0; i < sizeof(pure) / sizeof(pure[0]); i++)
+		if (fptr == pure[i])
+			return true;
+	return false;
+}
 
-	/*
-	 *  getline [var] < [file]
-	 *
-	 *  [ file (simp_exp)]
-	 *  [ [ var ] ]
-	 *  [ Op_K_getline_redir|NULL|redir_type|into_var]
-	 *  [ [var_assign] ]
-	 *
-	 */
+/*
+ * pure_op_pops --- for an instruction without side effects that pops
+ *	some values off the runtime stack and pushes one result, return
+ *	the number of values popped; otherwise return -1.
+ */
 
-	if (redir == NULL) {
-		int sline = op->source_line;
-		bcfree(op);
-		op = bcalloc(Op_K_getline, 2, sline);
-		(op + 1)->target_endfile = ip_endfile;
-		(op + 1)->target_beginfile = ip_beginfile;
-	}
+static int
+pure_op_pops(INSTRUCTION *ip)
+{
+	switch (ip->opcode) {
+	case Op_push:
+	case Op_push_arg:
+	case Op_push_i:
+	case Op_push_stack:
+	case Op_match_rec:
+		return 0;
 
-	if (var != NULL) {
-		tp = make_assignable(var->lasti);
-		assert(tp != NULL);
+	case Op_times_i:
+	case Op_quotient_i:
+	case Op_mod_i:
+	case Op_plus_i:
+	case Op_minus_i:
+	case Op_exp_i:
+	case Op_unary_minus:
+	case Op_unary_plus:
+	case Op_field_spec:
+	case Op_not:
+	case Op_and_final:
+	case Op_or_final:
+		return 1;
 
-		/* check if we need after_assign bytecode */
-		if (tp->opcode == Op_push_lhs
-				&& tp->memory->type == Node_var
-				&& tp->memory->var_assign
-		) {
-			asgn = instruction(Op_var_assign);
-			asgn->assign_ctxt = op->opcode;
-			asgn->assign_var = tp->memory->var_assign;
-		} else if (tp->opcode == Op_field_spec_lhs) {
-			asgn = instruction(Op_field_assign);
-			asgn->assign_ctxt = op->opcode;
-			asgn->field_assign = (Func_ptr) 0;   /* determined at run time */
-			tp->target_assign = asgn;
-		} else if (tp->opcode == Op_subscript_lhs) {
-			asgn = instruction(Op_subscript_assign);
-			asgn->assign_ctxt = op->opcode;
-		}
+	case Op_times:
+	case Op_quotient:
+	case Op_mod:
+	case Op_plus:
+	case Op_minus:
+	case Op_exp:
+	case Op_equal:
+	case Op_notequal:
+	case Op_less:
+	case Op_greater:
+	case Op_leq:
+	case Op_geq:
+	case Op_cmp_num:
+		return 2;
 
-		if (redir != NULL) {
-			ip = list_merge(redir, var);
-			(void) list_append(ip, op);
-		} else
-			ip = list_append(var, op);
-	} else if (redir != NULL)
-		ip = list_append(redir, op);
-	else
-		ip = list_create(op);
-	op->into_var = (var != NULL);
-	op->redir_type = (redir != NULL) ? redirtype : redirect_none;
+	case Op_match:
+	case Op_nomatch:
+		return (ip->memory->type == Node_dynregex) ? 2 : 1;
 
-	return (asgn == NULL ? ip : list_append(ip, asgn));
-}
+	case Op_concat:
+		return ip->expr_count;
 
+	case Op_builtin:
+		return pure_builtin(ip->builtin) ? ip->expr_count : -1;
 
-/* mk_for_loop --- for loop bytecodes */
+	default:
+		return -1;
+	}
+}
 
-static INSTRUCTION *
-mk_for_loop(INSTRUCTION *forp, INSTRUCTION *init, INSTRUCTION *cond,
-				INSTRUCTION *incr, INSTRUCTION *body)
+/* inline_target --- record the stack depth at a jump target in body[] */
+
+static bool
+inline_target(INSTRUCTION **body, int *depth, int count, int from, INSTRUCTION *target, int d)
 {
-	/*
-	 *   ------------------------
-	 *        init                 (may be NULL)
-	 *   ------------------------
-	 * x:
-	 *        cond                 (Op_no_op if NULL)
-	 *   ------------------------
-	 *    [ Op_jmp_false tb      ]
-	 *   ------------------------
-	 *        body                 (may be NULL)
-	 *   ------------------------
-	 * tc:
-	 *    incr                      (may be NULL)
-	 *    [ Op_jmp x             ]
-	 *   ------------------------
-	 * tb:[ Op_no_op             ]
-	 */
+	int i;
 
-	INSTRUCTION *ip, *tbreak, *tcont;
-	INSTRUCTION *jmp;
-	INSTRUCTION *pp_cond;
-	INSTRUCTION *ret;
+	for (i = from + 1; i < count; i++) {	/* forward jumps only */
+		if (body[i] == target) {
+			if (depth[i] >= 0 && depth[i] != d)
+				return false;
+			depth[i] = d;
+			return true;
+		}
+	}
+	return false;
+}
 
-	tbreak = instruction(Op_no_op);
+/*
+ * inline_candidate --- check whether f can be inlined at a call with nargs
+ *	arguments.  On success body[] holds the instructions of the body and
+ *	depth[] the depth of the runtime stack (above the arguments) before
+ *	each of them.
+ */
 
-	if (cond != NULL) {
-		add_lint(cond, LINT_assign_in_cond);
-		pp_cond = cond->nexti;
-		ip = cond;
-		(void) list_append(ip, instruction(Op_jmp_false));
-		ip->lasti->target_jmp = tbreak;
-	} else {
-		pp_cond = instruction(Op_no_op);
-		ip = list_create(pp_cond);
+static int
+inline_candidate(NODE *f, long nargs, INSTRUCTION **body, int *depth)
+{
+	INSTRUCTION *ip;
+	int count = 0;
+	int i, d, pops;
+	bool reachable;
+
+	if (f == NULL || f->type != Node_func || f->param_cnt != nargs)
+		return 0;
+
+	for (ip = f->code_ptr->nexti; ip != NULL; ip = ip->nexti) {
+		if (count == INLINE_MAX_INSNS)
+			return 0;
+		depth[count] = -1;
+		body[count++] = ip;
+	}
+
+	d = 0;
+	reachable = true;
+	for (i = 0; i < count; i++) {
+		ip = body[i];
+		if (depth[i] >= 0) {
+			if (reachable && depth[i] != d)
+				return 0;
+			d = depth[i];
+			reachable = true;
+		} else if (! reachable)
+			d = 0;		/* dead code, e.g. the implicit return */
+		depth[i] = d;
+
+		switch (ip->opcode) {
+		case Op_push:
+		case Op_push_arg:
+			if (ip->memory->type == Node_param_list
+					&& ip->memory->param_cnt >= nargs)
+				return 0;
+			d++;
+			break;
+
+		case Op_no_op:
+		case Op_parens:
+			break;
+
+		case Op_pop:
+			d--;
+			break;
+
+		case Op_jmp_false:
+		case Op_jmp_true:
+			d--;
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp, d))
+				return 0;
+			break;
+
+		case Op_jmp_cmp_false:
+		case Op_jmp_cmp_true:
+			d -= 2;
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp, d))
+				return 0;
+			break;
+
+		case Op_and:
+		case Op_or:
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp->nexti, d))
+				return 0;
+			d--;
+			break;
+
+		case Op_jmp:
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp, d))
+				return 0;
+			reachable = false;
+			break;
+
+		case Op_K_return:
+			if (reachable && d != 1)
+				return 0;
+			reachable = false;
+			break;
+
+		default:
+			pops = pure_op_pops(ip);
+			if (pops < 0)
+				return 0;
+			d += 1 - pops;
+			break;
+		}
+
+		if (d < 0)
+			return 0;
+	}
+
+	return count;
+}
+
+/* inline_call --- append a copy of the body of the function called at pc */
+
+static void
+inline_call(INSTRUCTION *pc, NODE *f, INSTRUCTION **body, int *depth, int count,
+		const char *caller_file)
+{
+	INSTRUCTION *copy[INLINE_MAX_INSNS];
+	INSTRUCTION *ip, *cp, *cont;
+	long nargs = (pc + 1)->expr_count;
+	bool same_file;
+	int i, j;
+
+	same_file = (caller_file != NULL && f->code_ptr->source_file != NULL
+			&& strcmp(caller_file, f->code_ptr->source_file) == 0);
+	cont = pc->nexti;
+
+	for (i = 0; i < count; i++)
+		copy[i] = bcalloc(body[i]->opcode, 1, 0);
+
+	for (i = 0; i < count; i++) {
+		ip = body[i];
+		cp = copy[i];
+		cp->d = ip->d;
+		cp->x = ip->x;
+		/* line numbers are only meaningful within the same source file */
+		if (same_file)
+			cp->source_line = ip->source_line;
+		cp->nexti = (i + 1 < count) ? copy[i + 1] : cont;
+
+		switch (ip->opcode) {
+		case Op_push:
+		case Op_push_arg:
+			if (ip->memory->type == Node_param_list) {
+				/* arguments are on the stack in order, last one on top */
+				cp->opcode = Op_push_stack;
+				cp->stack_offset = depth[i] + nargs - 1 - ip->memory->param_cnt;
+			}
+			break;
+
+		case Op_push_i:
+			cp->memory = dupnode(ip->memory);
+			break;
+
+		case Op_match_rec:
+		case Op_match:
+		case Op_nomatch:
+			if (ip->memory->type == Node_regex)
+				cp->memory = make_regnode(Node_regex, dupnode(ip->memory->re_exp));
+			else
+				cp->memory = make_regnode(Node_dynregex, NULL);
+			assert(cp->memory != NULL);
+			break;
+
+		case Op_and:
+		case Op_or:
+		case Op_jmp:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_jmp_cmp_false:
+		case Op_jmp_cmp_true:
+			for (j = 0; j < count; j++) {
+				if (body[j] == ip->target_jmp) {
+					cp->target_jmp = copy[j];
+					break;
+				}
+			}
+			assert(j < count);
+			break;
+
+		case Op_and_final:
+		case Op_or_final:
+			cp->target_stmt = NULL;		/* only used by the parser */
+			break;
+
+		case Op_K_return:
+			cp->opcode = Op_inline_return;
+			cp->target_jmp = cont;
+			cp->expr_count = nargs;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	pc->opcode = Op_func_call_inline;
+	pc->func_body = f;
+	pc->nexti = copy[0];
+	(pc + 1)->inline_last = copy[count - 1];
+
+	if (do_itrace)
+		fprintf(stderr, "inline\t%s\n", pc->func_name);
+}
+
+/*
+ * The names of the functions with a body small enough to inline, as bits
+ * of a filter, so that most calls that cannot be inlined need no lookup().
+ */
+static uint64_t inline_names;
+
+/* inline_name_bit --- the bit in inline_names for a function name */
+
+static uint64_t
+inline_name_bit(const char *name)
+{
+	unsigned long h = 0;
+
+	if (strncmp(name, "awk::", 5) == 0)
+		name += 5;	/* as in lookup() */
+	for (; *name != '\0'; name++)
+		h = h * 31 + (unsigned char) *name;
+	return (uint64_t) 1 << ((h ^ (h >> 6)) & 63);
+}
+
+/*
+ * inline_note_size --- add f to inline_names if its body of count
+ *	instructions is small enough.  Bodies only get smaller later on, so
+ *	at worst a call is not inlined.
+ */
+
+static void
+inline_note_size(NODE *f, int count)
+{
+	if (count <= INLINE_MAX_INSNS)
+		inline_names |= inline_name_bit(f->vname);
+}
+
+/* inline_calls --- inline eligible calls in a list of instructions */
+
+static void
+inline_calls(INSTRUCTION *code, const char *srcfile)
+{
+	INSTRUCTION *body[INLINE_MAX_INSNS];
+	int depth[INLINE_MAX_INSNS];
+	INSTRUCTION *pc;
+	NODE *f;
+	int count;
+
+	for (pc = code; pc != NULL; pc = pc->nexti) {
+		if (pc->opcode == Op_rule)
+			srcfile = pc->source_file;
+		if (pc->opcode != Op_func_call || pc->nexti == NULL)
+			continue;
+		f = pc->func_body;
+		if (f == NULL) {
+			if ((inline_names & inline_name_bit(pc->func_name)) == 0)
+				continue;
+			f = lookup(pc->func_name);
+		}
+		count = inline_candidate(f, (pc + 1)->expr_count, body, depth);
+		if (count > 0)
+			inline_call(pc, f, body, depth, count, srcfile);
+	}
+}
+
+/*
+ * mark_tail_call --- mark pc if it is `return f(...)' in the body of f.  At
+ *	run time such a call reuses the frame of the running function, if it can.
+ */
+
+static void
+mark_tail_call(INSTRUCTION *pc, NODE *f)
+{
+	if (pc->opcode == Op_func_call
+			&& pc->nexti != NULL
+			&& pc->nexti->opcode == Op_K_return
+			&& lookup(pc->func_name) == f
+	) {
+		pc->opcode = Op_tail_call;
+		pc->func_body = f;
+	}
+}
+
+/*
+ * Simple optimizations on the finished program, done by optimize_program()
+ * on the main program and on the body of each function:
+ *
+ * - A condition that is a constant, or a comparison of two numeric
+ *   constants, possibly negated, decides its conditional jump at parse
+ *   time; the branch that cannot be taken is never reached.  A variable
+ *   set with -v counts as a constant if the program never assigns it,
+ *   and has no other way to do so (SYMTAB, ARGV, extensions), so that
+ *   `if (DEBUG)' costs nothing when DEBUG is off.
+ *
+ * - In straight-line code, a repeated $n or length($n) with a constant n
+ *   becomes Op_push_stack, copying the value that is still on the
+ *   runtime stack from the first time, e.g. in `$3 * $3'.  Only
+ *   instructions without side effects are accepted in between, so the
+ *   fields cannot have changed.
+ *
+ * Concatenation of string constants is already done by the grammar.
+ */
+
+#define OPT_MAX_STACK	32
+
+enum opt_kind { OPT_OTHER, OPT_CONST, OPT_FIELD, OPT_LENGTH };
+
+struct opt_slot {
+	enum opt_kind kind;
+	long num;		/* field number for OPT_CONST, OPT_FIELD and OPT_LENGTH */
+};
+
+/*
+ * A set of pointers with a flag for each one, kept in an open addressing
+ * hash table.  Programs of tens of thousands of lines have hundreds of
+ * thousands of instructions, so this has to be cheap.  Most lookups are
+ * for pointers that are not there, and the bits in filter, one for each
+ * pointer added, turn most of those away without hashing.
+ */
+
+#define OPT_SMALL_TABLE	16	/* entries that need no allocation */
+
+struct opt_table {
+	const void **keys;
+	bool *flags;
+	size_t size;		/* a power of two */
+	size_t count;
+	uint64_t filter;
+	const void *small_keys[OPT_SMALL_TABLE];
+	bool small_flags[OPT_SMALL_TABLE];
+};
+
+/* opt_filter_bit --- the bit in opt_table.filter for p */
+#define opt_filter_bit(p)	((uint64_t) 1 << (((uintptr_t) (p) >> 3) & 63))
+
+/* opt_hash --- hash a pointer */
+
+static size_t
+opt_hash(const void *p, size_t size)
+{
+	uintptr_t h = (uintptr_t) p >> 4;
+
+	h ^= h >> 16;
+	h *= 0x45d9f3b;
+	h ^= h >> 16;
+	return h & (size - 1);
+}
+
+/*
+ * opt_lookup --- find the flag for p, adding p with the flag set if
+ *	insert is true.  Return NULL if p is not in the table.
+ */
+
+static bool *
+opt_lookup(struct opt_table *t, const void *p, bool insert)
+{
+	const void **old_keys;
+	bool *old_flags;
+	size_t i, j, old_size;
+
+	if ((t->filter & opt_filter_bit(p)) == 0) {
+		if (! insert)
+			return NULL;
+	} else {
+		for (i = opt_hash(p, t->size); t->keys[i] != NULL; i = (i + 1) & (t->size - 1))
+			if (t->keys[i] == p)
+				return & t->flags[i];
+		if (! insert)
+			return NULL;
+	}
+
+	if (2 * (t->count + 1) > t->size) {
+		old_keys = t->keys;
+		old_flags = t->flags;
+		old_size = t->size;
+		if (old_size == 0) {
+			/* most tables stay this small */
+			t->size = OPT_SMALL_TABLE;
+			t->keys = t->small_keys;
+			t->flags = t->small_flags;
+		} else {
+			t->size = 2 * old_size;
+			ezalloc(t->keys, const void **, t->size * sizeof(void *));
+			emalloc(t->flags, bool *, t->size * sizeof(bool));
+		}
+		for (j = 0; j < old_size; j++) {
+			if (old_keys[j] == NULL)
+				continue;
+			for (i = opt_hash(old_keys[j], t->size); t->keys[i] != NULL; i = (i + 1) & (t->size - 1))
+				;
+			t->keys[i] = old_keys[j];
+			t->flags[i] = old_flags[j];
+		}
+		if (old_keys != NULL && old_keys != t->small_keys) {
+			efree(old_keys);
+			efree(old_flags);
+		}
+	}
+
+	for (i = opt_hash(p, t->size); t->keys[i] != NULL; i = (i + 1) & (t->size - 1))
+		;
+	t->keys[i] = p;
+	t->flags[i] = true;
+	t->count++;
+	t->filter |= opt_filter_bit(p);
+	return & t->flags[i];
+}
+
+/* opt_free_table --- release the memory of a table */
+
+static void
+opt_free_table(struct opt_table *t)
+{
+	if (t->keys != NULL && t->keys != t->small_keys) {
+		efree(t->keys);
+		efree(t->flags);
+	}
+	memset(t, 0, sizeof(*t));
+}
+
+/*
+ * The instructions in the list being looked at that are reached other
+ * than through the nexti chain, mostly jump targets.  The table is filled
+ * again for each list, while its instructions are in the cache.  The
+ * passes only ever make instructions unreachable, so what it holds later
+ * on is too much rather than too little, which is safe.
+ */
+static struct opt_table opt_refs;
+
+/* opt_add_ref --- add a pointer to opt_refs */
+
+static void
+opt_add_ref(const void *p)
+{
+	if (p != NULL)
+		(void) opt_lookup(& opt_refs, p, true);
+}
+
+/* opt_main_refs --- add the targets in the main program to opt_refs */
+
+static void
+opt_main_refs(void)
+{
+	/* jumped to from the functions as well */
+	opt_add_ref(ip_rec);
+	opt_add_ref(ip_newfile);
+	opt_add_ref(ip_atexit);
+	opt_add_ref(ip_end);
+	opt_add_ref(ip_endfile);
+	opt_add_ref(ip_beginfile);
+}
+
+/* opt_collect_refs --- add the references made by the instruction at pc to opt_refs */
+
+static void
+opt_collect_refs(INSTRUCTION *pc)
+{
+	switch (pc->opcode) {
+	case Op_push:
+	case Op_push_i:
+	case Op_push_stack:
+	case Op_push_param:
+	case Op_push_arg:
+	case Op_push_arg_untyped:
+	case Op_push_lhs:
+	case Op_store_var:
+	case Op_assign:
+	case Op_assign_plus:
+	case Op_assign_minus:
+	case Op_assign_times:
+	case Op_assign_quotient:
+	case Op_assign_mod:
+	case Op_assign_exp:
+	case Op_preincrement:
+	case Op_predecrement:
+	case Op_postincrement:
+	case Op_postdecrement:
+	case Op_K_return:
+	case Op_field_spec:
+	case Op_no_op:
+	case Op_parens:
+	case Op_pop:
+	case Op_concat:
+	case Op_builtin:
+	case Op_func_call:
+	case Op_K_print:
+	case Op_K_printf:
+	case Op_match:
+	case Op_match_rec:
+	case Op_nomatch:
+		/* no jump targets */
+		return;
+	default:
+		if (pure_op_pops(pc) >= 0)
+			return;	/* arithmetic and comparisons */
+		break;
+	}
+	/* whatever the opcode, the pointers live in d and x */
+	opt_add_ref(pc->d.di);
+	opt_add_ref(pc->x.xi);
+	if (pc->opcode == Op_newfile || pc->opcode == Op_K_getline) {
+		opt_add_ref((pc + 1)->d.di);
+		opt_add_ref((pc + 1)->x.xi);
+	}
+}
+
+/* opt_is_ref --- true if p is in opt_refs */
+
+static inline bool
+opt_is_ref(const void *p)
+{
+	/* the filter alone answers most of the time */
+	return (opt_refs.filter & opt_filter_bit(p)) != 0
+		&& opt_lookup(& opt_refs, p, false) != NULL;
+}
+
+/* opt_list_refs --- fill opt_refs for a list, the main program if main_code */
+
+static void
+opt_list_refs(INSTRUCTION *code, bool main_code)
+{
+	INSTRUCTION *pc;
+
+	opt_free_table(& opt_refs);
+	if (main_code)
+		opt_main_refs();
+	for (pc = code; pc != NULL; pc = pc->nexti)
+		opt_collect_refs(pc);
+}
+
+/*
+ * Variables that may have been set with -v: the ones pushed somewhere,
+ * flagged as long as no other instruction refers to them.
+ */
+static struct opt_table opt_setvars;
+
+/* opt_collect_setvars --- add the variable pushed at pc to opt_setvars */
+
+static void
+opt_collect_setvars(INSTRUCTION *pc)
+{
+	if (pc->opcode == Op_push && pc->memory->type == Node_var
+			&& opt_lookup(& opt_setvars, pc->memory, false) == NULL
+			&& ! is_std_var(pc->memory->vname))
+		(void) opt_lookup(& opt_setvars, pc->memory, true);
+}
+
+/*
+ * opt_check_setvars --- keep the flag only for the variables in opt_setvars
+ *	that nothing else refers to, in the main program and the functions,
+ *	and that are not assigned on the command line.  Return false if
+ *	SYMTAB or ARGV is used, which could change any variable.
+ */
+
+static bool
+opt_check_setvars(INSTRUCTION **lists, NODE *argv_node)
+{
+	INSTRUCTION *pc;
+	const void *p;
+	NODE *var, *sub, *val;
+	bool *flag;
+	bool ok = true;
+	int i, j;
+	size_t k, n, vlen;
+	char *eq;
+
+	if (opt_setvars.count == 0)
+		return true;	/* nothing to look for */
+
+	for (i = 0; lists[i] != NULL; i++) {
+		for (pc = lists[i]; pc != NULL; pc = pc->nexti) {
+			if (pc->opcode == Op_push)
+				continue;
+			for (j = 0; j < 2; j++) {
+				p = (j == 0) ? (const void *) pc->d.dn : (const void *) pc->x.xn;
+				if (p == NULL)
+					continue;
+				if (p == argv_node || p == symbol_table)
+					ok = false;
+				else if ((flag = opt_lookup(& opt_setvars, p, false)) != NULL)
+					*flag = false;
+			}
+		}
+	}
+
+	/* an assignment on the command line changes it before the main rules */
+	for (n = 1; n < argv_node->table_size; n++) {
+		sub = make_number((double) n);
+		val = in_array(argv_node, sub);
+		unref(sub);
+		if (val == NULL || (val->flags & STRCUR) == 0
+				|| (eq = (char *) memchr(val->stptr, '=', val->stlen)) == NULL)
+			continue;
+		for (k = 0; k < opt_setvars.size; k++) {
+			if ((var = (NODE *) opt_setvars.keys[k]) == NULL || ! opt_setvars.flags[k])
+				continue;
+			vlen = strlen(var->vname);
+			if (eq - val->stptr >= vlen
+					&& memcmp(eq - vlen, var->vname, vlen) == 0)
+				opt_setvars.flags[k] = false;
+		}
+	}
+
+	return ok;
+}
+
+/* opt_cmp_type --- the comparison done by ip, or -1 */
+
+static int
+opt_cmp_type(INSTRUCTION *ip)
+{
+	switch (ip->opcode) {
+	case Op_equal:
+		return SCALAR_EQ;
+	case Op_notequal:
+		return SCALAR_NEQ;
+	case Op_less:
+		return SCALAR_LT;
+	case Op_leq:
+		return SCALAR_LE;
+	case Op_greater:
+		return SCALAR_GT;
+	case Op_geq:
+		return SCALAR_GE;
+	default:
+		return -1;
+	}
+}
+
+/* opt_follows --- true if target comes after pc in the list */
+
+static bool
+opt_follows(INSTRUCTION *pc, INSTRUCTION *target)
+{
+	for (pc = pc->nexti; pc != NULL; pc = pc->nexti)
+		if (pc == target)
+			return true;
+	return false;
+}
+
+/* opt_const_var --- true if the value of var is known at parse time */
+
+static bool
+opt_const_var(NODE *var)
+{
+	bool *flag;
+
+	return (var->type == Node_var
+		&& (flag = opt_lookup(& opt_setvars, var, false)) != NULL
+		&& *flag);
+}
+
+/* opt_const_value --- the value pushed by ip if known at parse time, else NULL */
+
+static NODE *
+opt_const_value(INSTRUCTION *ip, bool vars_ok)
+{
+	if (ip->opcode == Op_push_i) {
+		if ((ip->memory->flags & INTLSTR) != 0)
+			return NULL;
+		return ip->memory;
+	}
+	if (ip->opcode == Op_push && vars_ok && opt_const_var(ip->memory))
+		return ip->memory->var_value;
+	return NULL;
+}
+
+/*
+ * opt_fold_condition --- if pc starts a constant condition, replace it
+ *	with a no-op that goes straight to where the conditional jump
+ *	would go.  The rest of the condition is simply left unreachable.
+ */
+
+static void
+opt_fold_condition(INSTRUCTION *pc, bool vars_ok)
+{
+	INSTRUCTION *ip;
+	NODE *t1, *t2;
+	bool val, taken;
+
+	/* check the shape before looking at any values; this is called a lot */
+	if (pc->opcode != Op_push_i && pc->opcode != Op_push)
+		return;
+	ip = pc->nexti;
+	if (ip != NULL && (ip->opcode == Op_push_i || ip->opcode == Op_push))
+		ip = ip->nexti;
+	if (ip != NULL && opt_cmp_type(ip) >= 0)
+		ip = ip->nexti;
+	while (ip != NULL && (ip->opcode == Op_not || ip->opcode == Op_parens))
+		ip = ip->nexti;
+	if (ip == NULL || (ip->opcode != Op_jmp_false && ip->opcode != Op_jmp_true))
+		return;
+
+	if ((t1 = opt_const_value(pc, vars_ok)) == NULL)
+		return;
+
+	ip = pc->nexti;
+	if (ip == NULL || opt_is_ref(ip))
+		return;
+	if ((t2 = opt_const_value(ip, vars_ok)) != NULL) {
+		ip = ip->nexti;
+		if (do_mpfr || ip == NULL || opt_is_ref(ip))
+			return;
+		t1 = fixtype(t1);
+		t2 = fixtype(t2);
+		if (((t1->flags | t2->flags) & (STRING|REGEX)) != 0
+				|| isnan(t1->numbr) || isnan(t2->numbr))
+			return;
+
+		switch (ip->opcode) {
+		case Op_equal:
+			val = (t1->numbr == t2->numbr);
+			break;
+		case Op_notequal:
+			val = (t1->numbr != t2->numbr);
+			break;
+		case Op_less:
+			val = (t1->numbr < t2->numbr);
+			break;
+		case Op_greater:
+			val = (t1->numbr > t2->numbr);
+			break;
+		case Op_leq:
+			val = (t1->numbr <= t2->numbr);
+			break;
+		case Op_geq:
+			val = (t1->numbr >= t2->numbr);
+			break;
+		default:
+			return;
+		}
+		ip = ip->nexti;
+	} else
+		val = boolval(t1);
+
+	for (; ip != NULL; ip = ip->nexti) {
+		if (opt_is_ref(ip))
+			return;
+		if (ip->opcode == Op_not)
+			val = ! val;
+		else if (ip->opcode != Op_parens)
+			break;
+	}
+	if (ip == NULL)
+		return;
+
+	if (ip->opcode == Op_jmp_false)
+		taken = ! val;
+	else if (ip->opcode == Op_jmp_true)
+		taken = val;
+	else
+		return;
+
+	/* keep the list free of loops; it is walked from start to end */
+	if (taken && ! opt_follows(ip, ip->target_jmp))
+		return;
+
+	if (pc->opcode == Op_push_i)
+		unref(pc->memory);
+	pc->opcode = Op_no_op;
+	pc->memory = NULL;
+	pc->nexti = taken ? ip->target_jmp : ip->nexti;
+}
+
+/* opt_field_num --- true if ip pushes a constant usable as a field number */
+
+static bool
+opt_field_num(INSTRUCTION *ip, long *num)
+{
+	NODE *m;
+
+	if (ip->opcode != Op_push_i || do_mpfr)
+		return false;
+	m = ip->memory;
+	if ((m->flags & (NUMBER|STRING)) != NUMBER
+			|| m->numbr < 0 || m->numbr > INT_MAX
+			|| m->numbr != (long) m->numbr)
+		return false;
+	*num = (long) m->numbr;
+	return true;
+}
+
+/* opt_find_slot --- find the topmost slot with the given value, or -1 */
+
+static int
+opt_find_slot(const struct opt_slot *slots, int top, enum opt_kind kind, long num)
+{
+	int i;
+
+	for (i = top - 1; i >= 0; i--)
+		if (slots[i].kind == kind && slots[i].num == num)
+			return i;
+	return -1;
+}
+
+/*
+ * opt_reuse_fields --- keep track of what is on the runtime stack within
+ *	straight-line code, and reuse $n and length($n) already there.
+ */
+
+static void
+opt_reuse_fields(INSTRUCTION *code)
+{
+	struct opt_slot slots[OPT_MAX_STACK];
+	struct opt_slot slot;
+	INSTRUCTION *pc, *fs, *len, *next;
+	int top = 0;	/* number of known slots, the runtime stack may hold more */
+	int i, pops;
+	long num;
+
+	for (pc = code; pc != NULL; pc = pc->nexti) {
+		if (top > 0 && opt_is_ref(pc))
+			top = 0;	/* a jump target; anything could be on the stack */
+
+		if (opt_field_num(pc, & num)
+				&& (fs = pc->nexti)->opcode == Op_field_spec
+				&& ! opt_is_ref(fs)
+		) {
+			len = fs->nexti;
+			if (len->opcode != Op_builtin || len->builtin != do_length
+					|| len->expr_count != 1 || opt_is_ref(len))
+				len = NULL;
+
+			i = -1;
+			if (len != NULL)
+				i = opt_find_slot(slots, top, OPT_LENGTH, num);
+			if (i < 0) {
+				len = NULL;
+				i = opt_find_slot(slots, top, OPT_FIELD, num);
+			}
+			if (i >= 0) {
+				next = (len != NULL) ? len->nexti : fs->nexti;
+				if (len != NULL)
+					bcfree(len);
+				bcfree(fs);
+				unref(pc->memory);
+				pc->memory = NULL;
+				pc->opcode = Op_push_stack;
+				pc->stack_offset = top - 1 - i;
+				pc->nexti = next;
+			}
+		}
+
+		slot.kind = OPT_OTHER;
+		slot.num = 0;
+
+		switch (pc->opcode) {
+		case Op_no_op:
+		case Op_parens:
+			continue;
+
+		case Op_pop:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_and:
+		case Op_or:
+			pops = 1;
+			break;
+
+		case Op_push_i:
+			if (opt_field_num(pc, & slot.num))
+				slot.kind = OPT_CONST;
+			pops = 0;
+			break;
+
+		case Op_push_stack:
+			if (pc->stack_offset < top)
+				slot = slots[top - 1 - pc->stack_offset];
+			pops = 0;
+			break;
+
+		case Op_field_spec:
+			if (top > 0 && slots[top - 1].kind == OPT_CONST) {
+				slot.kind = OPT_FIELD;
+				slot.num = slots[top - 1].num;
+			}
+			pops = 1;
+			break;
+
+		default:
+			pops = pure_op_pops(pc);
+			if (pops < 0) {
+				top = 0;
+				continue;
+			}
+			if (pc->opcode == Op_builtin && pc->builtin == do_length
+					&& pops == 1 && top > 0
+					&& slots[top - 1].kind == OPT_FIELD
+			) {
+				slot.kind = OPT_LENGTH;
+				slot.num = slots[top - 1].num;
+			}
+			break;
+		}
+
+		top = (pops > top) ? 0 : top - pops;
+		switch (pc->opcode) {
+		case Op_pop:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_and:
+		case Op_or:
+			break;
+		default:
+			if (top == OPT_MAX_STACK)
+				top = 0;
+			slots[top++] = slot;
+			break;
+		}
+	}
+}
+
+/*
+ * Numeric variables.  A variable counts as numeric if every assignment to
+ * it stores a number: a numeric constant, the result of arithmetic, of ++
+ * or --, of a numeric builtin, or the value of another numeric variable.
+ * Starting with all variables numeric, the assignments are checked until
+ * nothing changes.  A comparison of two numeric values then becomes
+ * Op_cmp_num, which compares the two numbers directly, and together with
+ * a conditional jump that follows it, Op_jmp_cmp_true or Op_jmp_cmp_false.
+ *
+ * Nothing is really proven: the initial value of a variable, a command
+ * line assignment, SYMTAB or an extension can still give it a string
+ * value, so Op_cmp_num checks the values and falls back to the usual
+ * comparison if they are not plain numbers.
+ */
+
+/* the global scalar variables, flagged if they are still considered numeric */
+static struct opt_table opt_vars;
+
+/*
+ * The same for the parameters of the functions, all in one block; where
+ * those of each function start, once it has been looked at; and the
+ * function being looked at.
+ */
+static bool *opt_all_params;
+static size_t opt_all_params_count;
+static size_t opt_all_params_size;
+static size_t *opt_params_start;
+#define OPT_NOT_SEEN	((size_t) -1)
+static NODE *opt_func;
+static bool *opt_params;
+
+/* opt_collect_vars --- add the global scalar variable used at pc to opt_vars */
+
+static void
+opt_collect_vars(INSTRUCTION *pc)
+{
+	NODE *m;
+
+	if (pc->opcode != Op_push && pc->opcode != Op_push_lhs
+			&& pc->opcode != Op_store_var)
+		return;
+	m = pc->memory;
+	if ((m->type == Node_var || m->type == Node_var_new)
+			&& opt_lookup(& opt_vars, m, false) == NULL
+			&& ! is_std_var(m->vname))
+		(void) opt_lookup(& opt_vars, m, true);
+}
+
+/* opt_var_flag --- the flag for a variable or parameter, or NULL */
+
+static bool *
+opt_var_flag(const void *p)
+{
+	const NODE *m = (const NODE *) p;
+
+	if (opt_func != NULL && m >= opt_func->fparms
+			&& m < opt_func->fparms + opt_func->param_cnt)
+		return & opt_params[m - opt_func->fparms];
+	return opt_lookup(& opt_vars, p, false);
+}
+
+/* opt_store --- note an assignment to var; true if var is no longer numeric */
+
+static bool
+opt_store(const void *var, bool numeric)
+{
+	bool *flag;
+
+	if (numeric || var == NULL || (flag = opt_var_flag(var)) == NULL || ! *flag)
+		return false;
+	*flag = false;
+	return true;
+}
+
+/* opt_numeric_const --- true if m is a numeric constant */
+
+static bool
+opt_numeric_const(NODE *m)
+{
+	return (m->flags & (NUMBER|STRING|INTLSTR)) == NUMBER;
+}
+
+/* opt_numeric_result --- true if the value computed by ip is always a number */
+
+static bool
+opt_numeric_result(INSTRUCTION *ip)
+{
+	static NODE *(*const numeric[])(int) = {
+		do_length, do_index, do_int, do_sqrt, do_exp, do_log,
+		do_sin, do_cos, do_atan2, do_strtonum,
+		do_and, do_or, do_xor, do_compl, do_lshift, do_rshift,
+	};
+	size_t i;
+
+	switch (ip->opcode) {
+	case Op_field_spec:
+	case Op_concat:
+		return false;
+
+	case Op_builtin:
+		for (i = 0; i < sizeof(numeric) / sizeof(numeric[0]); i++)
+			if (ip->builtin == numeric[i])
+				return true;
+		return false;
+
+	default:
+		/* arithmetic, comparisons and matches */
+		return true;
+	}
+}
+
+/*
+ * opt_numeric_walk --- follow which values on the runtime stack are
+ *	numbers through a list of instructions.  Check the assignments, or
+ *	with rewrite, turn comparisons of numbers into Op_cmp_num.  Return
+ *	true if a variable was found not to be numeric.
+ */
+
+static bool
+opt_numeric_walk(INSTRUCTION *code, bool rewrite)
+{
+	bool num[OPT_MAX_STACK];
+	INSTRUCTION *pc, *jp;
+	bool changed = false;
+	bool res;
+	int top = 0;	/* number of known values, the runtime stack may hold more */
+	int pops, type;
+	bool *flag;
+
+	for (pc = code; pc != NULL; pc = pc->nexti) {
+		if (top > 0 && opt_is_ref(pc))
+			top = 0;	/* a jump target */
+
+		res = false;
+		pops = 0;
+
+		switch (pc->opcode) {
+		case Op_no_op:
+		case Op_parens:
+			continue;
+
+		case Op_push_i:
+			res = opt_numeric_const(pc->memory);
+			break;
+
+		case Op_push:
+		case Op_push_arg:
+		case Op_push_arg_untyped:
+			flag = opt_var_flag(pc->memory);
+			res = (flag != NULL && *flag);
+			break;
+
+		case Op_push_stack:
+			res = (pc->stack_offset < top && num[top - 1 - pc->stack_offset]);
+			break;
+
+		case Op_push_param:
+			break;
+
+		case Op_push_lhs:
+			switch (pc->nexti->opcode) {
+			case Op_preincrement:
+			case Op_predecrement:
+			case Op_postincrement:
+			case Op_postdecrement:
+			case Op_assign_plus:
+			case Op_assign_minus:
+			case Op_assign_times:
+			case Op_assign_quotient:
+			case Op_assign_mod:
+			case Op_assign_exp:
+				break;
+			case Op_assign:
+				changed |= opt_store(pc->memory, top > 0 && num[top - 1]);
+				break;
+			default:
+				/* getline, sub() and the like */
+				changed |= opt_store(pc->memory, false);
+				break;
+			}
+			break;
+
+		case Op_store_var:
+			if (pc->initval != NULL)
+				changed |= opt_store(pc->memory, opt_numeric_const(pc->initval));
+			else
+				changed |= opt_store(pc->memory, top > 0 && num[top - 1]);
+			top = (pc->initval != NULL || top == 0) ? top : top - 1;
+			continue;
+
+		case Op_postincrement:
+		case Op_postdecrement:
+			/* the old value is not needed as a statement */
+			if (rewrite && pc->nexti->opcode == Op_pop && ! opt_is_ref(pc->nexti))
+				pc->opcode = (pc->opcode == Op_postincrement)
+						? Op_preincrement : Op_predecrement;
+			/* fall through */
+		case Op_preincrement:
+		case Op_predecrement:
+			pops = 1;
+			res = true;
+			break;
+
+		case Op_assign_plus:
+		case Op_assign_minus:
+		case Op_assign_times:
+		case Op_assign_quotient:
+		case Op_assign_mod:
+		case Op_assign_exp:
+			pops = 2;
+			res = true;
+			break;
+
+		case Op_assign:
+			pops = 2;
+			res = (top >= 2 && num[top - 2]);
+			break;
+
+		case Op_pop:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_and:
+		case Op_or:
+			top = (top > 0) ? top - 1 : 0;
+			continue;
+
+		case Op_jmp_cmp_true:
+		case Op_jmp_cmp_false:
+			/* rewritten in an earlier round */
+			top = (top >= 2) ? top - 2 : 0;
+			continue;
+
+		default:
+			type = opt_cmp_type(pc);
+			if (type >= 0 && rewrite && ! do_mpfr
+					&& top >= 2 && num[top - 1] && num[top - 2]
+			) {
+				pc->opcode = Op_cmp_num;
+				pc->cmp_type = type;
+				jp = pc->nexti;
+				if ((jp->opcode == Op_jmp_false || jp->opcode == Op_jmp_true)
+						&& ! opt_is_ref(jp)
+				) {
+					pc->opcode = (jp->opcode == Op_jmp_true)
+							? Op_jmp_cmp_true : Op_jmp_cmp_false;
+					pc->target_jmp = jp->target_jmp;
+					pc->nexti = jp->nexti;
+					bcfree(jp);
+					top -= 2;
+					continue;
+				}
+			}
+
+			pops = pure_op_pops(pc);
+			if (pops < 0) {
+				/* anything could happen to the variables it uses */
+				changed |= opt_store(pc->memory, false);
+				changed |= opt_store(pc->x.xn, false);
+				top = 0;
+				continue;
+			}
+			res = opt_numeric_result(pc);
+			break;
+		}
+
+		top = (pops > top) ? 0 : top - pops;
+		if (top == OPT_MAX_STACK)
+			top = 0;
+		num[top++] = res;
+	}
+
+	return changed;
+}
+
+/*
+ * opt_numeric_start --- start with all the global variables found by
+ *	opt_collect_vars() numeric, and the parameters of nfuncs functions.
+ */
+
+static void
+opt_numeric_start(int nfuncs)
+{
+	int i;
+
+	if (nfuncs == 0)
+		return;
+	emalloc(opt_params_start, size_t *, nfuncs * sizeof(size_t));
+	for (i = 0; i < nfuncs; i++)
+		opt_params_start[i] = OPT_NOT_SEEN;
+}
+
+/*
+ * opt_numeric_list --- opt_numeric_walk() over the main program, lists[0],
+ *	or the body of funcs[i - 1] with its parameters, which are all numeric
+ *	the first time.
+ */
+
+static bool
+opt_numeric_list(INSTRUCTION **lists, NODE **funcs, int i, bool rewrite)
+{
+	size_t n;
+
+	opt_func = (i == 0) ? NULL : funcs[i - 1];
+	opt_params = NULL;
+	if (opt_func != NULL && opt_func->param_cnt > 0) {
+		if (opt_params_start[i - 1] == OPT_NOT_SEEN) {
+			n = opt_func->param_cnt;
+			if (opt_all_params_count + n > opt_all_params_size) {
+				opt_all_params_size = 2 * (opt_all_params_count + n);
+				if (opt_all_params == NULL)
+					emalloc(opt_all_params, bool *, opt_all_params_size * sizeof(bool));
+				else
+					erealloc(opt_all_params, bool *, opt_all_params_size * sizeof(bool));
+			}
+			memset(opt_all_params + opt_all_params_count, true, n * sizeof(bool));
+			opt_params_start[i - 1] = opt_all_params_count;
+			opt_all_params_count += n;
+		}
+		opt_params = opt_all_params + opt_params_start[i - 1];
+	}
+	return opt_numeric_walk(lists[i], rewrite);
+}
+
+/*
+ * opt_numeric_end --- forget what opt_numeric_start() and the walks found.
+ */
+
+static void
+opt_numeric_end(void)
+{
+	if (opt_params_start != NULL)
+		efree(opt_params_start);
+	if (opt_all_params != NULL)
+		efree(opt_all_params);
+	opt_params_start = NULL;
+	opt_all_params = NULL;
+	opt_all_params_count = opt_all_params_size = 0;
+	opt_func = NULL;
+	opt_params = NULL;
+	opt_free_table(& opt_vars);
+}
+
+/*
+ * opt_field_uses --- note the fields the instruction at pc can use, for
+ *	field projection; prev is the one before it.  If they are all given
+ *	as constants, and neither the fields other than $0 nor NF are ever
+ *	assigned to, the field splitting need not keep the others.  Return
+ *	false if it must.
+ */
+
+#define OPT_MAX_PROJECT	256	/* highest field number worth projecting */
+
+static bool
+opt_field_uses(INSTRUCTION *pc, INSTRUCTION *prev, bool *wanted, long *max)
+{
+	long num;
+
+	switch (pc->opcode) {
+	case Op_field_spec:
+		if (prev == NULL || ! opt_field_num(prev, & num)
+				|| num > OPT_MAX_PROJECT)
+			return false;	/* $i or $NF */
+		wanted[num] = true;
+		if (num > *max)
+			*max = num;
+		return true;
+
+	case Op_field_spec_lhs:
+	case Op_store_field:
+	case Op_store_field_exp:
+	case Op_field_assign:
+		/* $0 may be replaced, the others need all of $0 rebuilt */
+		return (prev != NULL && opt_field_num(prev, & num) && num == 0);
+
+	case Op_push:
+		return true;
+
+	default:
+		break;
+	}
+	/* NF changed, or SYMTAB which could change it */
+	return ! (pc->d.dn == NF_node || pc->x.xn == NF_node
+		  || pc->d.dn == symbol_table || pc->x.xn == symbol_table);
+}
+
+/*
+ * optimize_program --- optimize the program and all the functions.
+ *
+ * The passes go over each list of instructions in turn and do as much as
+ * they can with it while it is still in the cache.  For large programs,
+ * walking the instructions is what takes the time.
+ */
+
+static void
+optimize_program(INSTRUCTION *code)
+{
+	NODE **funcs = func_defs;
+	INSTRUCTION **lists;
+	NODE *argv_node;
+	SRCFILE *s;
+	bool vars_ok, fields_ok = true;
+	bool any_fields, changed;
+	bool *wanted;
+	long max = 0;
+	INSTRUCTION *pc, *prev;
+	int i, count, nfuncs = func_defs_count;
+
+	/* the main program, then the function bodies */
+	emalloc(lists, INSTRUCTION **, (nfuncs + 2) * sizeof(INSTRUCTION *));
+	lists[0] = code;
+	for (i = 0; i < nfuncs; i++)
+		lists[i + 1] = funcs[i]->code_ptr->nexti;
+	lists[nfuncs + 1] = NULL;
+
+	/* SYMTAB, ARGV and extensions can change any variable */
+	argv_node = lookup("ARGV");
+	vars_ok = (argv_node != NULL && argv_node->type == Node_var_array);
+	for (s = srcfiles->next; s != srcfiles; s = s->next)
+		if (s->stype == SRC_EXTLIB)
+			vars_ok = fields_ok = false;
+
+	/*
+	 * First find out what the whole program does, and do what needs
+	 * only the list at hand.  The first opt_numeric_list() walk over a
+	 * list knows all the global variables it uses.
+	 */
+	ezalloc(wanted, bool *, (OPT_MAX_PROJECT + 1) * sizeof(bool));
+	opt_numeric_start(nfuncs);
+	for (i = 0; lists[i] != NULL; i++) {
+		opt_free_table(& opt_refs);
+		if (i == 0)
+			opt_main_refs();
+		count = 0;
+		any_fields = false;
+		for (prev = NULL, pc = lists[i]; pc != NULL; prev = pc, pc = pc->nexti) {
+			count++;
+			opt_collect_refs(pc);
+			if (vars_ok)
+				opt_collect_setvars(pc);
+			opt_collect_vars(pc);
+			if (fields_ok)
+				fields_ok = opt_field_uses(pc, prev, wanted, & max);
+			if (pc->opcode == Op_field_spec)
+				any_fields = true;
+			if (i > 0)
+				mark_tail_call(pc, funcs[i - 1]);
+		}
+		if (! do_lint && any_fields)
+			opt_reuse_fields(lists[i]);
+		if (i > 0)
+			inline_note_size(funcs[i - 1], count);
+		(void) opt_numeric_list(lists, funcs, i, false);
+	}
+	if (vars_ok)
+		vars_ok = opt_check_setvars(lists, argv_node);
+	if (fields_ok)
+		set_field_projection(wanted, max);
+	else
+		efree(wanted);
+
+	/*
+	 * Then use the numeric variables, checking them again; most programs
+	 * need no further walks.  Inline last, after the rest is done with
+	 * the list.
+	 */
+	changed = false;
+	for (i = 0; lists[i] != NULL; i++) {
+		opt_list_refs(lists[i], i == 0);
+		for (pc = lists[i]; pc != NULL; pc = pc->nexti)
+			opt_fold_condition(pc, vars_ok);
+		changed |= opt_numeric_list(lists, funcs, i, true);
+		if (! do_lint)
+			inline_calls(lists[i], (i == 0) ? NULL
+					: funcs[i - 1]->code_ptr->source_file);
+	}
+	while (changed) {
+		changed = false;
+		for (i = 0; lists[i] != NULL; i++) {
+			opt_list_refs(lists[i], i == 0);
+			changed |= opt_numeric_list(lists, funcs, i, true);
+		}
+	}
+	inline_names = 0;
+	opt_free_table(& opt_setvars);
+	opt_numeric_end();
+	opt_free_table(& opt_refs);
+
+	efree(lists);
+}
+
+/* mk_getline --- make instructions for getline */
+
+static INSTRUCTION *
+mk_getline(INSTRUCTION *op, INSTRUCTION *var, INSTRUCTION *redir, int redirtype)
+{
+	INSTRUCTION *ip;
+	INSTRUCTION *tp;
+	INSTRUCTION *asgn = NULL;
+
+	/*
+	 *  getline [var] < [file]
+	 *
+	 *  [ file (simp_exp)]
+	 *  [ [ var ] ]
+	 *  [ Op_K_getline_redir|NULL|redir_type|into_var]
+	 *  [ [var_assign] ]
+	 *
+	 */
+
+	if (redir == NULL) {
+		int sline = op->source_line;
+		bcfree(op);
+		op = bcalloc(Op_K_getline, 2, sline);
+		(op + 1)->target_endfile = ip_endfile;
+		(op + 1)->target_beginfile = ip_beginfile;
+	}
+
+	if (var != NULL) {
+		tp = make_assignable(var->lasti);
+		assert(tp != NULL);
+
+		/* check if we need after_assign bytecode */
+		if (tp->opcode == Op_push_lhs
+				&& tp->memory->type == Node_var
+				&& tp->memory->var_assign
+		) {
+			asgn = instruction(Op_var_assign);
+			asgn->assign_ctxt = op->opcode;
+			asgn->assign_var = tp->memory->var_assign;
+		} else if (tp->opcode == Op_field_spec_lhs) {
+			asgn = instruction(Op_field_assign);
+			asgn->assign_ctxt = op->opcode;
+			asgn->field_assign = (Func_ptr) 0;   /* determined at run time */
+			tp->target_assign = asgn;
+		} else if (tp->opcode == Op_subscript_lhs) {
+			asgn = instruction(Op_subscript_assign);
+			asgn->assign_ctxt = op->opcode;
+		}
+
+		if (redir != NULL) {
+			ip = list_merge(redir, var);
+			(void) list_append(ip, op);
+		} else
+			ip = list_append(var, op);
+	} else if (redir != NULL)
+		ip = list_append(redir, op);
+	else
+		ip = list_create(op);
+	op->into_var = (var != NULL);
+	op->redir_type = (redir != NULL) ? redirtype : redirect_none;
+
+	return (asgn == NULL ? ip : list_append(ip, asgn));
+}
+
+
+/* mk_for_loop --- for loop bytecodes */
+
+static INSTRUCTION *
+mk_for_loop(INSTRUCTION *forp, INSTRUCTION *init, INSTRUCTION *cond,
+				INSTRUCTION *incr, INSTRUCTION *body)
+{
+	/*
+	 *   ------------------------
+	 *        init                 (may be NULL)
+	 *   ------------------------
+	 * x:
+	 *        cond                 (Op_no_op if NULL)
+	 *   ------------------------
+	 *    [ Op_jmp_false tb      ]
+	 *   ------------------------
+	 *        body                 (may be NULL)
+	 *   ------------------------
+	 * tc:
+	 *    incr                      (may be NULL)
+	 *    [ Op_jmp x             ]
+	 *   ------------------------
+	 * tb:[ Op_no_op             ]
+	 */
+
+	INSTRUCTION *ip, *tbreak, *tcont;
+	INSTRUCTION *jmp;
+	INSTRUCTION *pp_cond;
+	INSTRUCTION *ret;
+
+	tbreak = instruction(Op_no_op);
+
+	if (cond != NULL) {
+		add_lint(cond, LINT_assign_in_cond);
+		pp_cond = cond->nexti;
+		ip = cond;
+		(void) list_append(ip, instruction(Op_jmp_false));
+		ip->lasti->target_jmp = tbreak;
+	} else {
+		pp_cond = instruction(Op_no_op);
+		ip = list_create(pp_cond);
 	}
 
 	if (init != NULL)
@@ -9430,6 +10953,9 @@ qualify_name(const char *name, size_t len)
 	if (strchr(name, ':') != NULL)	// already qualified
 		return estrdup(name, len);
 
+	if (current_namespace == awk_namespace)	// nothing to add
+		return estrdup(name, len);
+
 	NODE *p = lookup(name);
 	if (p != NULL && p->type == Node_param_list)
 		return estrdup(name, len);
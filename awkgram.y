@@ -99,6 +99,7 @@ static INSTRUCTION *mk_assignment(INSTRUCTION *lhs, INSTRUCTION *rhs, INSTRUCTIO
 static INSTRUCTION *mk_getline(INSTRUCTION *op, INSTRUCTION *opt_var, INSTRUCTION *redir, int redirtype);
 static int count_expressions(INSTRUCTION **list, bool isarg);
 static INSTRUCTION *optimize_assignment(INSTRUCTION *exp);
+static void optimize_program(INSTRUCTION *code);
 static void add_lint(INSTRUCTION *list, LINTTYPE linttype);
 
 enum defref { FUNC_DEFINE, FUNC_USE, FUNC_EXT };
@@ -183,6 +184,11 @@ static bool called_from_eval = false;
 
 static bool include_use_current_namespace = false;
 
+/* the functions in the order they are defined, for optimize_program() */
+static NODE **func_defs = NULL;
+static int func_defs_count = 0;
+static int func_defs_size = 0;
+
 static inline INSTRUCTION *list_create(INSTRUCTION *x);
 static inline INSTRUCTION *list_append(INSTRUCTION *l, INSTRUCTION *x);
 static inline INSTRUCTION *list_prepend(INSTRUCTION *l, INSTRUCTION *x);
@@ -2777,6 +2783,15 @@ parse_program(INSTRUCTION **pcode, bool from_eval)
 	if (ret == 0)	/* avoid spurious warning if parser aborted with YYABORT */
 		check_funcs();
 
+	if (ret == 0 && errcount == 0 && do_optimize && ! do_debug
+			&& in_main_context())
+		optimize_program(*pcode);
+
+	if (func_defs != NULL)
+		efree(func_defs);
+	func_defs = NULL;
+	func_defs_count = func_defs_size = 0;
+
 	if (do_posix && ! check_param_names())
 		errcount++;
 
@@ -4890,6 +4905,7 @@ dump_vars(const char *fname)
 	vars = variable_list();
 	print_vars(vars, fprintf, fp);
 	efree(vars);
+	print_field_projection(fp);
 	if (fp != stdout && fp != stderr && fclose(fp) != 0)
 		warning(_("%s: close failed: %s"), fname, strerror(errno));
 }
@@ -5032,6 +5048,16 @@ install_function(char *fname, INSTRUCTION *fi, INSTRUCTION *plist)
 	f->param_cnt = pcount;
 	f->code_ptr = fi;
 	f->fparms = NULL;
+
+	if (func_defs_count == func_defs_size) {
+		func_defs_size = (func_defs_size == 0) ? 64 : 2 * func_defs_size;
+		if (func_defs == NULL)
+			emalloc(func_defs, NODE **, func_defs_size * sizeof(NODE *));
+		else
+			erealloc(func_defs, NODE **, func_defs_size * sizeof(NODE *));
+	}
+	func_defs[func_defs_count++] = f;
+
 	if (pcount > 0) {
 		char **pnames;
 		pnames = check_params(fname, pcount, plist);	/* frees plist */
@@ -5106,7 +5132,35 @@ static struct fdesc {
 	short defined;
 	short extension;
 	struct fdesc *next;
-} *ftable[HASHSIZE];
+} **ftable;
+
+static unsigned long ftable_size;	/* HASHSIZE, more for large programs */
+static unsigned long ftable_count;
+
+/* grow_ftable --- make the function table larger, or allocate it */
+
+static void
+grow_ftable()
+{
+	struct fdesc **old = ftable;
+	unsigned long oldsize = ftable_size;
+	struct fdesc *fp, *next;
+	unsigned long i, ind;
+
+	ftable_size = (old == NULL) ? HASHSIZE : 4 * oldsize + 1;
+	ezalloc(ftable, struct fdesc **, ftable_size * sizeof(struct fdesc *));
+
+	for (i = 0; i < oldsize; i++) {
+		for (fp = old[i]; fp != NULL; fp = next) {
+			next = fp->next;
+			ind = hash(fp->name, strlen(fp->name), ftable_size, NULL);
+			fp->next = ftable[ind];
+			ftable[ind] = fp;
+		}
+	}
+	if (old != NULL)
+		efree(old);
+}
 
 /* func_use --- track uses and definitions of functions */
 
@@ -5117,8 +5171,11 @@ func_use(const char *name, enum defref how)
 	int len;
 	int ind;
 
+	if (ftable == NULL)
+		grow_ftable();
+
 	len = strlen(name);
-	ind = hash(name, len, HASHSIZE, NULL);
+	ind = hash(name, len, ftable_size, NULL);
 
 	for (fp = ftable[ind]; fp != NULL; fp = fp->next)
 		if (strcmp(fp->name, name) == 0)
@@ -5126,11 +5183,18 @@ func_use(const char *name, enum defref how)
 
 	/* not in the table, fall through to allocate a new one */
 
+	if (ftable_count >= 2 * ftable_size) {
+		/* keep the chains short for large libraries */
+		grow_ftable();
+		ind = hash(name, len, ftable_size, NULL);
+	}
+
 	ezalloc(fp, struct fdesc *, sizeof(struct fdesc));
 	emalloc(fp->name, char *, len + 1);
 	strcpy(fp->name, name);
 	fp->next = ftable[ind];
 	ftable[ind] = fp;
+	ftable_count++;
 
 update_value:
 	if (how == FUNC_DEFINE)
@@ -5156,12 +5220,15 @@ static void
 check_funcs()
 {
 	struct fdesc *fp, *next;
-	int i;
+	unsigned long i;
+
+	if (ftable == NULL)
+		return;
 
 	if (! in_main_context())
 		goto free_mem;
 
-	for (i = 0; i < HASHSIZE; i++) {
+	for (i = 0; i < ftable_size; i++) {
 		for (fp = ftable[i]; fp != NULL; fp = fp->next) {
 			if (do_lint && ! fp->extension) {
 				/*
@@ -5182,14 +5249,16 @@ check_funcs()
 
 free_mem:
 	/* now let's free all the memory */
-	for (i = 0; i < HASHSIZE; i++) {
+	for (i = 0; i < ftable_size; i++) {
 		for (fp = ftable[i]; fp != NULL; fp = next) {
 			next = fp->next;
 			efree(fp->name);
 			efree(fp);
 		}
-		ftable[i] = NULL;
 	}
+	efree(ftable);
+	ftable = NULL;
+	ftable_size = ftable_count = 0;
 }
 
 /* param_sanity --- look for parameters that are regexp constants */
@@ -6035,185 +6104,1698 @@ optimize_assignment(INSTRUCTION *exp)
 }
 
 
-/* mk_getline --- make instructions for getline */
+/*
+ * Function inlining.
+ *
+ * A call to a small function whose body only computes a value from its
+ * (scalar) parameters, constants and global variables is followed by a
+ * private copy of that body.  The call instruction becomes
+ * Op_func_call_inline; at run time it checks that all the arguments are
+ * scalar values and if so simply falls into the copy, which picks up
+ * the arguments straight from the runtime stack (Op_push_stack) and
+ * leaves the return value in their place (Op_inline_return).  If an
+ * argument is an untyped variable or an array, a real call is made
+ * instead, and the function returns to the instruction after the copy.
+ *
+ * Only straight-line code and forward branches (if-else, ?:, && and ||)
+ * are accepted, with no assignments and no calls other than to a
+ * handful of builtins without side effects.
+ */
 
-static INSTRUCTION *
-mk_getline(INSTRUCTION *op, INSTRUCTION *var, INSTRUCTION *redir, int redirtype)
+#define INLINE_MAX_INSNS	30
+
+/* pure_builtin --- true if the builtin has no side effects */
+
+static bool
+pure_builtin(NODE *(*fptr)(int))
 {
-	INSTRUCTION *ip;
-	INSTRUCTION *tp;
-	INSTRUCTION *asgn = NULL;
+	static NODE *(*const pure[])(int) = {
+		do_length, do_substr, do_index, do_tolower, do_toupper,
+		do_int, do_sqrt, do_exp, do_log, do_sin, do_cos, do_atan2,
+		do_sprintf, do_strtonum,
+		do_and, do_or, do_xor, do_compl, do_lshift, do_rshift,
+	};
+	size_t i;
+
+	for (i = 0; i < sizeof(pure) / sizeof(pure[0]); i++)
+		if (fptr == pure[i])
+			return true;
+	return false;
+}
 
-	/*
-	 *  getline [var] < [file]
-	 *
-	 *  [ file (simp_exp)]
-	 *  [ [ var ] ]
-	 *  [ Op_K_getline_redir|NULL|redir_type|into_var]
-	 *  [ [var_assign] ]
-	 *
-	 */
+/*
+ * pure_op_pops --- for an instruction without side effects that pops
+ *	some values off the runtime stack and pushes one result, return
+ *	the number of values popped; otherwise return -1.
+ */
 
-	if (redir == NULL) {
-		int sline = op->source_line;
-		bcfree(op);
-		op = bcalloc(Op_K_getline, 2, sline);
-		(op + 1)->target_endfile = ip_endfile;
-		(op + 1)->target_beginfile = ip_beginfile;
-	}
+static int
+pure_op_pops(INSTRUCTION *ip)
+{
+	switch (ip->opcode) {
+	case Op_push:
+	case Op_push_arg:
+	case Op_push_i:
+	case Op_push_stack:
+	case Op_match_rec:
+		return 0;
 
-	if (var != NULL) {
-		tp = make_assignable(var->lasti);
-		assert(tp != NULL);
+	case Op_times_i:
+	case Op_quotient_i:
+	case Op_mod_i:
+	case Op_plus_i:
+	case Op_minus_i:
+	case Op_exp_i:
+	case Op_unary_minus:
+	case Op_unary_plus:
+	case Op_field_spec:
+	case Op_not:
+	case Op_and_final:
+	case Op_or_final:
+		return 1;
 
-		/* check if we need after_assign bytecode */
-		if (tp->opcode == Op_push_lhs
-				&& tp->memory->type == Node_var
-				&& tp->memory->var_assign
-		) {
-			asgn = instruction(Op_var_assign);
-			asgn->assign_ctxt = op->opcode;
-			asgn->assign_var = tp->memory->var_assign;
-		} else if (tp->opcode == Op_field_spec_lhs) {
-			asgn = instruction(Op_field_assign);
-			asgn->assign_ctxt = op->opcode;
-			asgn->field_assign = (Func_ptr) 0;   /* determined at run time */
-			tp->target_assign = asgn;
-		} else if (tp->opcode == Op_subscript_lhs) {
-			asgn = instruction(Op_subscript_assign);
-			asgn->assign_ctxt = op->opcode;
-		}
+	case Op_times:
+	case Op_quotient:
+	case Op_mod:
+	case Op_plus:
+	case Op_minus:
+	case Op_exp:
+	case Op_equal:
+	case Op_notequal:
+	case Op_less:
+	case Op_greater:
+	case Op_leq:
+	case Op_geq:
+	case Op_cmp_num:
+		return 2;
 
-		if (redir != NULL) {
-			ip = list_merge(redir, var);
-			(void) list_append(ip, op);
-		} else
-			ip = list_append(var, op);
-	} else if (redir != NULL)
-		ip = list_append(redir, op);
-	else
-		ip = list_create(op);
-	op->into_var = (var != NULL);
-	op->redir_type = (redir != NULL) ? redirtype : redirect_none;
+	case Op_match:
+	case Op_nomatch:
+		return (ip->memory->type == Node_dynregex) ? 2 : 1;
 
-	return (asgn == NULL ? ip : list_append(ip, asgn));
-}
+	case Op_concat:
+		return ip->expr_count;
 
+	case Op_builtin:
+		return pure_builtin(ip->builtin) ? ip->expr_count : -1;
 
-/* mk_for_loop --- for loop bytecodes */
+	default:
+		return -1;
+	}
+}
 
-static INSTRUCTION *
-mk_for_loop(INSTRUCTION *forp, INSTRUCTION *init, INSTRUCTION *cond,
-				INSTRUCTION *incr, INSTRUCTION *body)
+/* inline_target --- record the stack depth at a jump target in body[] */
+
+static bool
+inline_target(INSTRUCTION **body, int *depth, int count, int from, INSTRUCTION *target, int d)
 {
-	/*
-	 *   ------------------------
-	 *        init                 (may be NULL)
-	 *   ------------------------
-	 * x:
-	 *        cond                 (Op_no_op if NULL)
-	 *   ------------------------
-	 *    [ Op_jmp_false tb      ]
-	 *   ------------------------
-	 *        body                 (may be NULL)
-	 *   ------------------------
-	 * tc:
-	 *    incr                      (may be NULL)
-	 *    [ Op_jmp x             ]
-	 *   ------------------------
-	 * tb:[ Op_no_op             ]
-	 */
+	int i;
 
-	INSTRUCTION *ip, *tbreak, *tcont;
-	INSTRUCTION *jmp;
-	INSTRUCTION *pp_cond;
-	INSTRUCTION *ret;
+	for (i = from + 1; i < count; i++) {	/* forward jumps only */
+		if (body[i] == target) {
+			if (depth[i] >= 0 && depth[i] != d)
+				return false;
+			depth[i] = d;
+			return true;
+		}
+	}
+	return false;
+}
 
-	tbreak = instruction(Op_no_op);
+/*
+ * inline_candidate --- check whether f can be inlined at a call with nargs
+ *	arguments.  On success body[] holds the instructions of the body and
+ *	depth[] the depth of the runtime stack (above the arguments) before
+ *	each of them.
+ */
 
-	if (cond != NULL) {
-		add_lint(cond, LINT_assign_in_cond);
-		pp_cond = cond->nexti;
-		ip = cond;
-		(void) list_append(ip, instruction(Op_jmp_false));
-		ip->lasti->target_jmp = tbreak;
-	} else {
-		pp_cond = instruction(Op_no_op);
-		ip = list_create(pp_cond);
-	}
+static int
+inline_candidate(NODE *f, long nargs, INSTRUCTION **body, int *depth)
+{
+	INSTRUCTION *ip;
+	int count = 0;
+	int i, d, pops;
+	bool reachable;
 
-	if (init != NULL)
-		ip = list_merge(init, ip);
+	if (f == NULL || f->type != Node_func || f->param_cnt != nargs)
+		return 0;
 
-	if (do_pretty_print) {
-		(void) list_append(ip, instruction(Op_exec_count));
-		(forp + 1)->forloop_cond = pp_cond;
-		(forp + 1)->forloop_body = ip->lasti;
+	for (ip = f->code_ptr->nexti; ip != NULL; ip = ip->nexti) {
+		if (count == INLINE_MAX_INSNS)
+			return 0;
+		depth[count] = -1;
+		body[count++] = ip;
 	}
 
-	if (body != NULL)
-		(void) list_merge(ip, body);
+	d = 0;
+	reachable = true;
+	for (i = 0; i < count; i++) {
+		ip = body[i];
+		if (depth[i] >= 0) {
+			if (reachable && depth[i] != d)
+				return 0;
+			d = depth[i];
+			reachable = true;
+		} else if (! reachable)
+			d = 0;		/* dead code, e.g. the implicit return */
+		depth[i] = d;
 
-	jmp = instruction(Op_jmp);
-	jmp->target_jmp = pp_cond;
-	if (incr == NULL)
-		tcont = jmp;
-	else {
-		tcont = incr->nexti;
-		(void) list_merge(ip, incr);
-	}
+		switch (ip->opcode) {
+		case Op_push:
+		case Op_push_arg:
+			if (ip->memory->type == Node_param_list
+					&& ip->memory->param_cnt >= nargs)
+				return 0;
+			d++;
+			break;
 
-	(void) list_append(ip, jmp);
-	ret = list_append(ip, tbreak);
-	fix_break_continue(ret, tbreak, tcont);
+		case Op_no_op:
+		case Op_parens:
+			break;
 
-	if (do_pretty_print) {
-		forp->target_break = tbreak;
-		forp->target_continue = tcont;
-		ret = list_prepend(ret, forp);
+		case Op_pop:
+			d--;
+			break;
+
+		case Op_jmp_false:
+		case Op_jmp_true:
+			d--;
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp, d))
+				return 0;
+			break;
+
+		case Op_jmp_cmp_false:
+		case Op_jmp_cmp_true:
+			d -= 2;
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp, d))
+				return 0;
+			break;
+
+		case Op_and:
+		case Op_or:
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp->nexti, d))
+				return 0;
+			d--;
+			break;
+
+		case Op_jmp:
+			if (reachable && ! inline_target(body, depth, count, i, ip->target_jmp, d))
+				return 0;
+			reachable = false;
+			break;
+
+		case Op_K_return:
+			if (reachable && d != 1)
+				return 0;
+			reachable = false;
+			break;
+
+		default:
+			pops = pure_op_pops(ip);
+			if (pops < 0)
+				return 0;
+			d += 1 - pops;
+			break;
+		}
+
+		if (d < 0)
+			return 0;
 	}
-	/* else
-		forp is NULL */
 
-	return ret;
+	return count;
 }
 
-/* add_lint --- add lint warning bytecode if needed */
+/* inline_call --- append a copy of the body of the function called at pc */
 
 static void
-add_lint(INSTRUCTION *list, LINTTYPE linttype)
+inline_call(INSTRUCTION *pc, NODE *f, INSTRUCTION **body, int *depth, int count,
+		const char *caller_file)
 {
-#ifndef NO_LINT
-	INSTRUCTION *ip;
-	bool no_effect = true;
-
-	switch (linttype) {
-	case LINT_assign_in_cond:
-		ip = list->lasti;
-		if (ip->opcode == Op_var_assign || ip->opcode == Op_field_assign) {
-			assert(ip != list->nexti);
-			for (ip = list->nexti; ip->nexti != list->lasti; ip = ip->nexti)
-				;
-		}
+	INSTRUCTION *copy[INLINE_MAX_INSNS];
+	INSTRUCTION *ip, *cp, *cont;
+	long nargs = (pc + 1)->expr_count;
+	bool same_file;
+	int i, j;
 
-		if (ip->opcode == Op_assign || ip->opcode == Op_assign_concat) {
-			list_append(list, instruction(Op_lint));
-			list->lasti->lint_type = linttype;
-		}
-		break;
+	same_file = (caller_file != NULL && f->code_ptr->source_file != NULL
+			&& strcmp(caller_file, f->code_ptr->source_file) == 0);
+	cont = pc->nexti;
 
-	case LINT_no_effect:
-		if (list->lasti->opcode == Op_pop && list->nexti != list->lasti) {
-			int line = 0;
+	for (i = 0; i < count; i++)
+		copy[i] = bcalloc(body[i]->opcode, 1, 0);
 
-			// Get down to the last instruction ...
-			for (ip = list->nexti; ip->nexti != list->lasti; ip = ip->nexti) {
-				// ... along the way track line numbers, we will use the line
-				// closest to the opcode if that opcode doesn't have one
-				if (ip->source_line != 0)
-					line = ip->source_line;
+	for (i = 0; i < count; i++) {
+		ip = body[i];
+		cp = copy[i];
+		cp->d = ip->d;
+		cp->x = ip->x;
+		/* line numbers are only meaningful within the same source file */
+		if (same_file)
+			cp->source_line = ip->source_line;
+		cp->nexti = (i + 1 < count) ? copy[i + 1] : cont;
 
-				// And check each opcode for no effect
+		switch (ip->opcode) {
+		case Op_push:
+		case Op_push_arg:
+			if (ip->memory->type == Node_param_list) {
+				/* arguments are on the stack in order, last one on top */
+				cp->opcode = Op_push_stack;
+				cp->stack_offset = depth[i] + nargs - 1 - ip->memory->param_cnt;
+			}
+			break;
+
+		case Op_push_i:
+			cp->memory = dupnode(ip->memory);
+			break;
+
+		case Op_match_rec:
+		case Op_match:
+		case Op_nomatch:
+			if (ip->memory->type == Node_regex)
+				cp->memory = make_regnode(Node_regex, dupnode(ip->memory->re_exp));
+			else
+				cp->memory = make_regnode(Node_dynregex, NULL);
+			assert(cp->memory != NULL);
+			break;
+
+		case Op_and:
+		case Op_or:
+		case Op_jmp:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_jmp_cmp_false:
+		case Op_jmp_cmp_true:
+			for (j = 0; j < count; j++) {
+				if (body[j] == ip->target_jmp) {
+					cp->target_jmp = copy[j];
+					break;
+				}
+			}
+			assert(j < count);
+			break;
+
+		case Op_and_final:
+		case Op_or_final:
+			cp->target_stmt = NULL;		/* only used by the parser */
+			break;
+
+		case Op_K_return:
+			cp->opcode = Op_inline_return;
+			cp->target_jmp = cont;
+			cp->expr_count = nargs;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	pc->opcode = Op_func_call_inline;
+	pc->func_body = f;
+	pc->nexti = copy[0];
+	(pc + 1)->inline_last = copy[count - 1];
+
+	if (do_itrace)
+		fprintf(stderr, "inline\t%s\n", pc->func_name);
+}
+
+/*
+ * The names of the functions with a body small enough to inline, as bits
+ * of a filter, so that most calls that cannot be inlined need no lookup().
+ */
+static uint64_t inline_names;
+
+/* inline_name_bit --- the bit in inline_names for a function name */
+
+static uint64_t
+inline_name_bit(const char *name)
+{
+	unsigned long h = 0;
+
+	if (strncmp(name, "awk::", 5) == 0)
+		name += 5;	/* as in lookup() */
+	for (; *name != '\0'; name++)
+		h = h * 31 + (unsigned char) *name;
+	return (uint64_t) 1 << ((h ^ (h >> 6)) & 63);
+}
+
+/*
+ * inline_note_size --- add f to inline_names if its body of count
+ *	instructions is small enough.  Bodies only get smaller later on, so
+ *	at worst a call is not inlined.
+ */
+
+static void
+inline_note_size(NODE *f, int count)
+{
+	if (count <= INLINE_MAX_INSNS)
+		inline_names |= inline_name_bit(f->vname);
+}
+
+/* inline_calls --- inline eligible calls in a list of instructions */
+
+static void
+inline_calls(INSTRUCTION *code, const char *srcfile)
+{
+	INSTRUCTION *body[INLINE_MAX_INSNS];
+	int depth[INLINE_MAX_INSNS];
+	INSTRUCTION *pc;
+	NODE *f;
+	int count;
+
+	for (pc = code; pc != NULL; pc = pc->nexti) {
+		if (pc->opcode == Op_rule)
+			srcfile = pc->source_file;
+		if (pc->opcode != Op_func_call || pc->nexti == NULL)
+			continue;
+		f = pc->func_body;
+		if (f == NULL) {
+			if ((inline_names & inline_name_bit(pc->func_name)) == 0)
+				continue;
+			f = lookup(pc->func_name);
+		}
+		count = inline_candidate(f, (pc + 1)->expr_count, body, depth);
+		if (count > 0)
+			inline_call(pc, f, body, depth, count, srcfile);
+	}
+}
+
+/*
+ * mark_tail_call --- mark pc if it is `return f(...)' in the body of f.  At
+ *	run time such a call reuses the frame of the running function, if it can.
+ */
+
+static void
+mark_tail_call(INSTRUCTION *pc, NODE *f)
+{
+	if (pc->opcode == Op_func_call
+			&& pc->nexti != NULL
+			&& pc->nexti->opcode == Op_K_return
+			&& lookup(pc->func_name) == f
+	) {
+		pc->opcode = Op_tail_call;
+		pc->func_body = f;
+	}
+}
+
+/*
+ * Simple optimizations on the finished program, done by optimize_program()
+ * on the main program and on the body of each function:
+ *
+ * - A condition that is a constant, or a comparison of two numeric
+ *   constants, possibly negated, decides its conditional jump at parse
+ *   time; the branch that cannot be taken is never reached.  A variable
+ *   set with -v counts as a constant if the program never assigns it,
+ *   and has no other way to do so (SYMTAB, ARGV, extensions), so that
+ *   `if (DEBUG)' costs nothing when DEBUG is off.
+ *
+ * - In straight-line code, a repeated $n or length($n) with a constant n
+ *   becomes Op_push_stack, copying the value that is still on the
+ *   runtime stack from the first time, e.g. in `$3 * $3'.  Only
+ *   instructions without side effects are accepted in between, so the
+ *   fields cannot have changed.
+ *
+ * Concatenation of string constants is already done by the grammar.
+ */
+
+#define OPT_MAX_STACK	32
+
+enum opt_kind { OPT_OTHER, OPT_CONST, OPT_FIELD, OPT_LENGTH };
+
+struct opt_slot {
+	enum opt_kind kind;
+	long num;		/* field number for OPT_CONST, OPT_FIELD and OPT_LENGTH */
+};
+
+/*
+ * A set of pointers with a flag for each one, kept in an open addressing
+ * hash table.  Programs of tens of thousands of lines have hundreds of
+ * thousands of instructions, so this has to be cheap.  Most lookups are
+ * for pointers that are not there, and the bits in filter, one for each
+ * pointer added, turn most of those away without hashing.
+ */
+
+#define OPT_SMALL_TABLE	16	/* entries that need no allocation */
+
+struct opt_table {
+	const void **keys;
+	bool *flags;
+	size_t size;		/* a power of two */
+	size_t count;
+	uint64_t filter;
+	const void *small_keys[OPT_SMALL_TABLE];
+	bool small_flags[OPT_SMALL_TABLE];
+};
+
+/* opt_filter_bit --- the bit in opt_table.filter for p */
+#define opt_filter_bit(p)	((uint64_t) 1 << (((uintptr_t) (p) >> 3) & 63))
+
+/* opt_hash --- hash a pointer */
+
+static size_t
+opt_hash(const void *p, size_t size)
+{
+	uintptr_t h = (uintptr_t) p >> 4;
+
+	h ^= h >> 16;
+	h *= 0x45d9f3b;
+	h ^= h >> 16;
+	return h & (size - 1);
+}
+
+/*
+ * opt_lookup --- find the flag for p, adding p with the flag set if
+ *	insert is true.  Return NULL if p is not in the table.
+ */
+
+static bool *
+opt_lookup(struct opt_table *t, const void *p, bool insert)
+{
+	const void **old_keys;
+	bool *old_flags;
+	size_t i, j, old_size;
+
+	if ((t->filter & opt_filter_bit(p)) == 0) {
+		if (! insert)
+			return NULL;
+	} else {
+		for (i = opt_hash(p, t->size); t->keys[i] != NULL; i = (i + 1) & (t->size - 1))
+			if (t->keys[i] == p)
+				return & t->flags[i];
+		if (! insert)
+			return NULL;
+	}
+
+	if (2 * (t->count + 1) > t->size) {
+		old_keys = t->keys;
+		old_flags = t->flags;
+		old_size = t->size;
+		if (old_size == 0) {
+			/* most tables stay this small */
+			t->size = OPT_SMALL_TABLE;
+			t->keys = t->small_keys;
+			t->flags = t->small_flags;
+		} else {
+			t->size = 2 * old_size;
+			ezalloc(t->keys, const void **, t->size * sizeof(void *));
+			emalloc(t->flags, bool *, t->size * sizeof(bool));
+		}
+		for (j = 0; j < old_size; j++) {
+			if (old_keys[j] == NULL)
+				continue;
+			for (i = opt_hash(old_keys[j], t->size); t->keys[i] != NULL; i = (i + 1) & (t->size - 1))
+				;
+			t->keys[i] = old_keys[j];
+			t->flags[i] = old_flags[j];
+		}
+		if (old_keys != NULL && old_keys != t->small_keys) {
+			efree(old_keys);
+			efree(old_flags);
+		}
+	}
+
+	for (i = opt_hash(p, t->size); t->keys[i] != NULL; i = (i + 1) & (t->size - 1))
+		;
+	t->keys[i] = p;
+	t->flags[i] = true;
+	t->count++;
+	t->filter |= opt_filter_bit(p);
+	return & t->flags[i];
+}
+
+/* opt_free_table --- release the memory of a table */
+
+static void
+opt_free_table(struct opt_table *t)
+{
+	if (t->keys != NULL && t->keys != t->small_keys) {
+		efree(t->keys);
+		efree(t->flags);
+	}
+	memset(t, 0, sizeof(*t));
+}
+
+/*
+ * The instructions in the list being looked at that are reached other
+ * than through the nexti chain, mostly jump targets.  The table is filled
+ * again for each list, while its instructions are in the cache.  The
+ * passes only ever make instructions unreachable, so what it holds later
+ * on is too much rather than too little, which is safe.
+ */
+static struct opt_table opt_refs;
+
+/* opt_add_ref --- add a pointer to opt_refs */
+
+static void
+opt_add_ref(const void *p)
+{
+	if (p != NULL)
+		(void) opt_lookup(& opt_refs, p, true);
+}
+
+/* opt_main_refs --- add the targets in the main program to opt_refs */
+
+static void
+opt_main_refs(void)
+{
+	/* jumped to from the functions as well */
+	opt_add_ref(ip_rec);
+	opt_add_ref(ip_newfile);
+	opt_add_ref(ip_atexit);
+	opt_add_ref(ip_end);
+	opt_add_ref(ip_endfile);
+	opt_add_ref(ip_beginfile);
+}
+
+/* opt_collect_refs --- add the references made by the instruction at pc to opt_refs */
+
+static void
+opt_collect_refs(INSTRUCTION *pc)
+{
+	switch (pc->opcode) {
+	case Op_push:
+	case Op_push_i:
+	case Op_push_stack:
+	case Op_push_param:
+	case Op_push_arg:
+	case Op_push_arg_untyped:
+	case Op_push_lhs:
+	case Op_store_var:
+	case Op_assign:
+	case Op_assign_plus:
+	case Op_assign_minus:
+	case Op_assign_times:
+	case Op_assign_quotient:
+	case Op_assign_mod:
+	case Op_assign_exp:
+	case Op_preincrement:
+	case Op_predecrement:
+	case Op_postincrement:
+	case Op_postdecrement:
+	case Op_K_return:
+	case Op_field_spec:
+	case Op_no_op:
+	case Op_parens:
+	case Op_pop:
+	case Op_concat:
+	case Op_builtin:
+	case Op_func_call:
+	case Op_K_print:
+	case Op_K_printf:
+	case Op_match:
+	case Op_match_rec:
+	case Op_nomatch:
+		/* no jump targets */
+		return;
+	default:
+		if (pure_op_pops(pc) >= 0)
+			return;	/* arithmetic and comparisons */
+		break;
+	}
+	/* whatever the opcode, the pointers live in d and x */
+	opt_add_ref(pc->d.di);
+	opt_add_ref(pc->x.xi);
+	if (pc->opcode == Op_newfile || pc->opcode == Op_K_getline) {
+		opt_add_ref((pc + 1)->d.di);
+		opt_add_ref((pc + 1)->x.xi);
+	}
+}
+
+/* opt_is_ref --- true if p is in opt_refs */
+
+static inline bool
+opt_is_ref(const void *p)
+{
+	/* the filter alone answers most of the time */
+	return (opt_refs.filter & opt_filter_bit(p)) != 0
+		&& opt_lookup(& opt_refs, p, false) != NULL;
+}
+
+/* opt_list_refs --- fill opt_refs for a list, the main program if main_code */
+
+static void
+opt_list_refs(INSTRUCTION *code, bool main_code)
+{
+	INSTRUCTION *pc;
+
+	opt_free_table(& opt_refs);
+	if (main_code)
+		opt_main_refs();
+	for (pc = code; pc != NULL; pc = pc->nexti)
+		opt_collect_refs(pc);
+}
+
+/*
+ * Variables that may have been set with -v: the ones pushed somewhere,
+ * flagged as long as no other instruction refers to them.
+ */
+static struct opt_table opt_setvars;
+
+/* opt_collect_setvars --- add the variable pushed at pc to opt_setvars */
+
+static void
+opt_collect_setvars(INSTRUCTION *pc)
+{
+	if (pc->opcode == Op_push && pc->memory->type == Node_var
+			&& opt_lookup(& opt_setvars, pc->memory, false) == NULL
+			&& ! is_std_var(pc->memory->vname))
+		(void) opt_lookup(& opt_setvars, pc->memory, true);
+}
+
+/*
+ * opt_check_setvars --- keep the flag only for the variables in opt_setvars
+ *	that nothing else refers to, in the main program and the functions,
+ *	and that are not assigned on the command line.  Return false if
+ *	SYMTAB or ARGV is used, which could change any variable.
+ */
+
+static bool
+opt_check_setvars(INSTRUCTION **lists, NODE *argv_node)
+{
+	INSTRUCTION *pc;
+	const void *p;
+	NODE *var, *sub, *val;
+	bool *flag;
+	bool ok = true;
+	int i, j;
+	size_t k, n, vlen;
+	char *eq;
+
+	if (opt_setvars.count == 0)
+		return true;	/* nothing to look for */
+
+	for (i = 0; lists[i] != NULL; i++) {
+		for (pc = lists[i]; pc != NULL; pc = pc->nexti) {
+			if (pc->opcode == Op_push)
+				continue;
+			for (j = 0; j < 2; j++) {
+				p = (j == 0) ? (const void *) pc->d.dn : (const void *) pc->x.xn;
+				if (p == NULL)
+					continue;
+				if (p == argv_node || p == symbol_table)
+					ok = false;
+				else if ((flag = opt_lookup(& opt_setvars, p, false)) != NULL)
+					*flag = false;
+			}
+		}
+	}
+
+	/* an assignment on the command line changes it before the main rules */
+	for (n = 1; n < argv_node->table_size; n++) {
+		sub = make_number((double) n);
+		val = in_array(argv_node, sub);
+		unref(sub);
+		if (val == NULL || (val->flags & STRCUR) == 0
+				|| (eq = (char *) memchr(val->stptr, '=', val->stlen)) == NULL)
+			continue;
+		for (k = 0; k < opt_setvars.size; k++) {
+			if ((var = (NODE *) opt_setvars.keys[k]) == NULL || ! opt_setvars.flags[k])
+				continue;
+			vlen = strlen(var->vname);
+			if (eq - val->stptr >= vlen
+					&& memcmp(eq - vlen, var->vname, vlen) == 0)
+				opt_setvars.flags[k] = false;
+		}
+	}
+
+	return ok;
+}
+
+/* opt_cmp_type --- the comparison done by ip, or -1 */
+
+static int
+opt_cmp_type(INSTRUCTION *ip)
+{
+	switch (ip->opcode) {
+	case Op_equal:
+		return SCALAR_EQ;
+	case Op_notequal:
+		return SCALAR_NEQ;
+	case Op_less:
+		return SCALAR_LT;
+	case Op_leq:
+		return SCALAR_LE;
+	case Op_greater:
+		return SCALAR_GT;
+	case Op_geq:
+		return SCALAR_GE;
+	default:
+		return -1;
+	}
+}
+
+/* opt_follows --- true if target comes after pc in the list */
+
+static bool
+opt_follows(INSTRUCTION *pc, INSTRUCTION *target)
+{
+	for (pc = pc->nexti; pc != NULL; pc = pc->nexti)
+		if (pc == target)
+			return true;
+	return false;
+}
+
+/* opt_const_var --- true if the value of var is known at parse time */
+
+static bool
+opt_const_var(NODE *var)
+{
+	bool *flag;
+
+	return (var->type == Node_var
+		&& (flag = opt_lookup(& opt_setvars, var, false)) != NULL
+		&& *flag);
+}
+
+/* opt_const_value --- the value pushed by ip if known at parse time, else NULL */
+
+static NODE *
+opt_const_value(INSTRUCTION *ip, bool vars_ok)
+{
+	if (ip->opcode == Op_push_i) {
+		if ((ip->memory->flags & INTLSTR) != 0)
+			return NULL;
+		return ip->memory;
+	}
+	if (ip->opcode == Op_push && vars_ok && opt_const_var(ip->memory))
+		return ip->memory->var_value;
+	return NULL;
+}
+
+/*
+ * opt_fold_condition --- if pc starts a constant condition, replace it
+ *	with a no-op that goes straight to where the conditional jump
+ *	would go.  The rest of the condition is simply left unreachable.
+ */
+
+static void
+opt_fold_condition(INSTRUCTION *pc, bool vars_ok)
+{
+	INSTRUCTION *ip;
+	NODE *t1, *t2;
+	bool val, taken;
+
+	/* check the shape before looking at any values; this is called a lot */
+	if (pc->opcode != Op_push_i && pc->opcode != Op_push)
+		return;
+	ip = pc->nexti;
+	if (ip != NULL && (ip->opcode == Op_push_i || ip->opcode == Op_push))
+		ip = ip->nexti;
+	if (ip != NULL && opt_cmp_type(ip) >= 0)
+		ip = ip->nexti;
+	while (ip != NULL && (ip->opcode == Op_not || ip->opcode == Op_parens))
+		ip = ip->nexti;
+	if (ip == NULL || (ip->opcode != Op_jmp_false && ip->opcode != Op_jmp_true))
+		return;
+
+	if ((t1 = opt_const_value(pc, vars_ok)) == NULL)
+		return;
+
+	ip = pc->nexti;
+	if (ip == NULL || opt_is_ref(ip))
+		return;
+	if ((t2 = opt_const_value(ip, vars_ok)) != NULL) {
+		ip = ip->nexti;
+		if (do_mpfr || ip == NULL || opt_is_ref(ip))
+			return;
+		t1 = fixtype(t1);
+		t2 = fixtype(t2);
+		if (((t1->flags | t2->flags) & (STRING|REGEX)) != 0
+				|| isnan(t1->numbr) || isnan(t2->numbr))
+			return;
+
+		switch (ip->opcode) {
+		case Op_equal:
+			val = (t1->numbr == t2->numbr);
+			break;
+		case Op_notequal:
+			val = (t1->numbr != t2->numbr);
+			break;
+		case Op_less:
+			val = (t1->numbr < t2->numbr);
+			break;
+		case Op_greater:
+			val = (t1->numbr > t2->numbr);
+			break;
+		case Op_leq:
+			val = (t1->numbr <= t2->numbr);
+			break;
+		case Op_geq:
+			val = (t1->numbr >= t2->numbr);
+			break;
+		default:
+			return;
+		}
+		ip = ip->nexti;
+	} else
+		val = boolval(t1);
+
+	for (; ip != NULL; ip = ip->nexti) {
+		if (opt_is_ref(ip))
+			return;
+		if (ip->opcode == Op_not)
+			val = ! val;
+		else if (ip->opcode != Op_parens)
+			break;
+	}
+	if (ip == NULL)
+		return;
+
+	if (ip->opcode == Op_jmp_false)
+		taken = ! val;
+	else if (ip->opcode == Op_jmp_true)
+		taken = val;
+	else
+		return;
+
+	/* keep the list free of loops; it is walked from start to end */
+	if (taken && ! opt_follows(ip, ip->target_jmp))
+		return;
+
+	if (pc->opcode == Op_push_i)
+		unref(pc->memory);
+	pc->opcode = Op_no_op;
+	pc->memory = NULL;
+	pc->nexti = taken ? ip->target_jmp : ip->nexti;
+}
+
+/* opt_field_num --- true if ip pushes a constant usable as a field number */
+
+static bool
+opt_field_num(INSTRUCTION *ip, long *num)
+{
+	NODE *m;
+
+	if (ip->opcode != Op_push_i || do_mpfr)
+		return false;
+	m = ip->memory;
+	if ((m->flags & (NUMBER|STRING)) != NUMBER
+			|| m->numbr < 0 || m->numbr > INT_MAX
+			|| m->numbr != (long) m->numbr)
+		return false;
+	*num = (long) m->numbr;
+	return true;
+}
+
+/* opt_find_slot --- find the topmost slot with the given value, or -1 */
+
+static int
+opt_find_slot(const struct opt_slot *slots, int top, enum opt_kind kind, long num)
+{
+	int i;
+
+	for (i = top - 1; i >= 0; i--)
+		if (slots[i].kind == kind && slots[i].num == num)
+			return i;
+	return -1;
+}
+
+/*
+ * opt_reuse_fields --- keep track of what is on the runtime stack within
+ *	straight-line code, and reuse $n and length($n) already there.
+ */
+
+static void
+opt_reuse_fields(INSTRUCTION *code)
+{
+	struct opt_slot slots[OPT_MAX_STACK];
+	struct opt_slot slot;
+	INSTRUCTION *pc, *fs, *len, *next;
+	int top = 0;	/* number of known slots, the runtime stack may hold more */
+	int i, pops;
+	long num;
+
+	for (pc = code; pc != NULL; pc = pc->nexti) {
+		if (top > 0 && opt_is_ref(pc))
+			top = 0;	/* a jump target; anything could be on the stack */
+
+		if (opt_field_num(pc, & num)
+				&& (fs = pc->nexti)->opcode == Op_field_spec
+				&& ! opt_is_ref(fs)
+		) {
+			len = fs->nexti;
+			if (len->opcode != Op_builtin || len->builtin != do_length
+					|| len->expr_count != 1 || opt_is_ref(len))
+				len = NULL;
+
+			i = -1;
+			if (len != NULL)
+				i = opt_find_slot(slots, top, OPT_LENGTH, num);
+			if (i < 0) {
+				len = NULL;
+				i = opt_find_slot(slots, top, OPT_FIELD, num);
+			}
+			if (i >= 0) {
+				next = (len != NULL) ? len->nexti : fs->nexti;
+				if (len != NULL)
+					bcfree(len);
+				bcfree(fs);
+				unref(pc->memory);
+				pc->memory = NULL;
+				pc->opcode = Op_push_stack;
+				pc->stack_offset = top - 1 - i;
+				pc->nexti = next;
+			}
+		}
+
+		slot.kind = OPT_OTHER;
+		slot.num = 0;
+
+		switch (pc->opcode) {
+		case Op_no_op:
+		case Op_parens:
+			continue;
+
+		case Op_pop:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_and:
+		case Op_or:
+			pops = 1;
+			break;
+
+		case Op_push_i:
+			if (opt_field_num(pc, & slot.num))
+				slot.kind = OPT_CONST;
+			pops = 0;
+			break;
+
+		case Op_push_stack:
+			if (pc->stack_offset < top)
+				slot = slots[top - 1 - pc->stack_offset];
+			pops = 0;
+			break;
+
+		case Op_field_spec:
+			if (top > 0 && slots[top - 1].kind == OPT_CONST) {
+				slot.kind = OPT_FIELD;
+				slot.num = slots[top - 1].num;
+			}
+			pops = 1;
+			break;
+
+		default:
+			pops = pure_op_pops(pc);
+			if (pops < 0) {
+				top = 0;
+				continue;
+			}
+			if (pc->opcode == Op_builtin && pc->builtin == do_length
+					&& pops == 1 && top > 0
+					&& slots[top - 1].kind == OPT_FIELD
+			) {
+				slot.kind = OPT_LENGTH;
+				slot.num = slots[top - 1].num;
+			}
+			break;
+		}
+
+		top = (pops > top) ? 0 : top - pops;
+		switch (pc->opcode) {
+		case Op_pop:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_and:
+		case Op_or:
+			break;
+		default:
+			if (top == OPT_MAX_STACK)
+				top = 0;
+			slots[top++] = slot;
+			break;
+		}
+	}
+}
+
+/*
+ * Numeric variables.  A variable counts as numeric if every assignment to
+ * it stores a number: a numeric constant, the result of arithmetic, of ++
+ * or --, of a numeric builtin, or the value of another numeric variable.
+ * Starting with all variables numeric, the assignments are checked until
+ * nothing changes.  A comparison of two numeric values then becomes
+ * Op_cmp_num, which compares the two numbers directly, and together with
+ * a conditional jump that follows it, Op_jmp_cmp_true or Op_jmp_cmp_false.
+ *
+ * Nothing is really proven: the initial value of a variable, a command
+ * line assignment, SYMTAB or an extension can still give it a string
+ * value, so Op_cmp_num checks the values and falls back to the usual
+ * comparison if they are not plain numbers.
+ */
+
+/* the global scalar variables, flagged if they are still considered numeric */
+static struct opt_table opt_vars;
+
+/*
+ * The same for the parameters of the functions, all in one block; where
+ * those of each function start, once it has been looked at; and the
+ * function being looked at.
+ */
+static bool *opt_all_params;
+static size_t opt_all_params_count;
+static size_t opt_all_params_size;
+static size_t *opt_params_start;
+#define OPT_NOT_SEEN	((size_t) -1)
+static NODE *opt_func;
+static bool *opt_params;
+
+/* opt_collect_vars --- add the global scalar variable used at pc to opt_vars */
+
+static void
+opt_collect_vars(INSTRUCTION *pc)
+{
+	NODE *m;
+
+	if (pc->opcode != Op_push && pc->opcode != Op_push_lhs
+			&& pc->opcode != Op_store_var)
+		return;
+	m = pc->memory;
+	if ((m->type == Node_var || m->type == Node_var_new)
+			&& opt_lookup(& opt_vars, m, false) == NULL
+			&& ! is_std_var(m->vname))
+		(void) opt_lookup(& opt_vars, m, true);
+}
+
+/* opt_var_flag --- the flag for a variable or parameter, or NULL */
+
+static bool *
+opt_var_flag(const void *p)
+{
+	const NODE *m = (const NODE *) p;
+
+	if (opt_func != NULL && m >= opt_func->fparms
+			&& m < opt_func->fparms + opt_func->param_cnt)
+		return & opt_params[m - opt_func->fparms];
+	return opt_lookup(& opt_vars, p, false);
+}
+
+/* opt_store --- note an assignment to var; true if var is no longer numeric */
+
+static bool
+opt_store(const void *var, bool numeric)
+{
+	bool *flag;
+
+	if (numeric || var == NULL || (flag = opt_var_flag(var)) == NULL || ! *flag)
+		return false;
+	*flag = false;
+	return true;
+}
+
+/* opt_numeric_const --- true if m is a numeric constant */
+
+static bool
+opt_numeric_const(NODE *m)
+{
+	return (m->flags & (NUMBER|STRING|INTLSTR)) == NUMBER;
+}
+
+/* opt_numeric_result --- true if the value computed by ip is always a number */
+
+static bool
+opt_numeric_result(INSTRUCTION *ip)
+{
+	static NODE *(*const numeric[])(int) = {
+		do_length, do_index, do_int, do_sqrt, do_exp, do_log,
+		do_sin, do_cos, do_atan2, do_strtonum,
+		do_and, do_or, do_xor, do_compl, do_lshift, do_rshift,
+	};
+	size_t i;
+
+	switch (ip->opcode) {
+	case Op_field_spec:
+	case Op_concat:
+		return false;
+
+	case Op_builtin:
+		for (i = 0; i < sizeof(numeric) / sizeof(numeric[0]); i++)
+			if (ip->builtin == numeric[i])
+				return true;
+		return false;
+
+	default:
+		/* arithmetic, comparisons and matches */
+		return true;
+	}
+}
+
+/*
+ * opt_numeric_walk --- follow which values on the runtime stack are
+ *	numbers through a list of instructions.  Check the assignments, or
+ *	with rewrite, turn comparisons of numbers into Op_cmp_num.  Return
+ *	true if a variable was found not to be numeric.
+ */
+
+static bool
+opt_numeric_walk(INSTRUCTION *code, bool rewrite)
+{
+	bool num[OPT_MAX_STACK];
+	INSTRUCTION *pc, *jp;
+	bool changed = false;
+	bool res;
+	int top = 0;	/* number of known values, the runtime stack may hold more */
+	int pops, type;
+	bool *flag;
+
+	for (pc = code; pc != NULL; pc = pc->nexti) {
+		if (top > 0 && opt_is_ref(pc))
+			top = 0;	/* a jump target */
+
+		res = false;
+		pops = 0;
+
+		switch (pc->opcode) {
+		case Op_no_op:
+		case Op_parens:
+			continue;
+
+		case Op_push_i:
+			res = opt_numeric_const(pc->memory);
+			break;
+
+		case Op_push:
+		case Op_push_arg:
+		case Op_push_arg_untyped:
+			flag = opt_var_flag(pc->memory);
+			res = (flag != NULL && *flag);
+			break;
+
+		case Op_push_stack:
+			res = (pc->stack_offset < top && num[top - 1 - pc->stack_offset]);
+			break;
+
+		case Op_push_param:
+			break;
+
+		case Op_push_lhs:
+			switch (pc->nexti->opcode) {
+			case Op_preincrement:
+			case Op_predecrement:
+			case Op_postincrement:
+			case Op_postdecrement:
+			case Op_assign_plus:
+			case Op_assign_minus:
+			case Op_assign_times:
+			case Op_assign_quotient:
+			case Op_assign_mod:
+			case Op_assign_exp:
+				break;
+			case Op_assign:
+				changed |= opt_store(pc->memory, top > 0 && num[top - 1]);
+				break;
+			default:
+				/* getline, sub() and the like */
+				changed |= opt_store(pc->memory, false);
+				break;
+			}
+			break;
+
+		case Op_store_var:
+			if (pc->initval != NULL)
+				changed |= opt_store(pc->memory, opt_numeric_const(pc->initval));
+			else
+				changed |= opt_store(pc->memory, top > 0 && num[top - 1]);
+			top = (pc->initval != NULL || top == 0) ? top : top - 1;
+			continue;
+
+		case Op_postincrement:
+		case Op_postdecrement:
+			/* the old value is not needed as a statement */
+			if (rewrite && pc->nexti->opcode == Op_pop && ! opt_is_ref(pc->nexti))
+				pc->opcode = (pc->opcode == Op_postincrement)
+						? Op_preincrement : Op_predecrement;
+			/* fall through */
+		case Op_preincrement:
+		case Op_predecrement:
+			pops = 1;
+			res = true;
+			break;
+
+		case Op_assign_plus:
+		case Op_assign_minus:
+		case Op_assign_times:
+		case Op_assign_quotient:
+		case Op_assign_mod:
+		case Op_assign_exp:
+			pops = 2;
+			res = true;
+			break;
+
+		case Op_assign:
+			pops = 2;
+			res = (top >= 2 && num[top - 2]);
+			break;
+
+		case Op_pop:
+		case Op_jmp_false:
+		case Op_jmp_true:
+		case Op_and:
+		case Op_or:
+			top = (top > 0) ? top - 1 : 0;
+			continue;
+
+		case Op_jmp_cmp_true:
+		case Op_jmp_cmp_false:
+			/* rewritten in an earlier round */
+			top = (top >= 2) ? top - 2 : 0;
+			continue;
+
+		default:
+			type = opt_cmp_type(pc);
+			if (type >= 0 && rewrite && ! do_mpfr
+					&& top >= 2 && num[top - 1] && num[top - 2]
+			) {
+				pc->opcode = Op_cmp_num;
+				pc->cmp_type = type;
+				jp = pc->nexti;
+				if ((jp->opcode == Op_jmp_false || jp->opcode == Op_jmp_true)
+						&& ! opt_is_ref(jp)
+				) {
+					pc->opcode = (jp->opcode == Op_jmp_true)
+							? Op_jmp_cmp_true : Op_jmp_cmp_false;
+					pc->target_jmp = jp->target_jmp;
+					pc->nexti = jp->nexti;
+					bcfree(jp);
+					top -= 2;
+					continue;
+				}
+			}
+
+			pops = pure_op_pops(pc);
+			if (pops < 0) {
+				/* anything could happen to the variables it uses */
+				changed |= opt_store(pc->memory, false);
+				changed |= opt_store(pc->x.xn, false);
+				top = 0;
+				continue;
+			}
+			res = opt_numeric_result(pc);
+			break;
+		}
+
+		top = (pops > top) ? 0 : top - pops;
+		if (top == OPT_MAX_STACK)
+			top = 0;
+		num[top++] = res;
+	}
+
+	return changed;
+}
+
+/*
+ * opt_numeric_start --- start with all the global variables found by
+ *	opt_collect_vars() numeric, and the parameters of nfuncs functions.
+ */
+
+static void
+opt_numeric_start(int nfuncs)
+{
+	int i;
+
+	if (nfuncs == 0)
+		return;
+	emalloc(opt_params_start, size_t *, nfuncs * sizeof(size_t));
+	for (i = 0; i < nfuncs; i++)
+		opt_params_start[i] = OPT_NOT_SEEN;
+}
+
+/*
+ * opt_numeric_list --- opt_numeric_walk() over the main program, lists[0],
+ *	or the body of funcs[i - 1] with its parameters, which are all numeric
+ *	the first time.
+ */
+
+static bool
+opt_numeric_list(INSTRUCTION **lists, NODE **funcs, int i, bool rewrite)
+{
+	size_t n;
+
+	opt_func = (i == 0) ? NULL : funcs[i - 1];
+	opt_params = NULL;
+	if (opt_func != NULL && opt_func->param_cnt > 0) {
+		if (opt_params_start[i - 1] == OPT_NOT_SEEN) {
+			n = opt_func->param_cnt;
+			if (opt_all_params_count + n > opt_all_params_size) {
+				opt_all_params_size = 2 * (opt_all_params_count + n);
+				if (opt_all_params == NULL)
+					emalloc(opt_all_params, bool *, opt_all_params_size * sizeof(bool));
+				else
+					erealloc(opt_all_params, bool *, opt_all_params_size * sizeof(bool));
+			}
+			memset(opt_all_params + opt_all_params_count, true, n * sizeof(bool));
+			opt_params_start[i - 1] = opt_all_params_count;
+			opt_all_params_count += n;
+		}
+		opt_params = opt_all_params + opt_params_start[i - 1];
+	}
+	return opt_numeric_walk(lists[i], rewrite);
+}
+
+/*
+ * opt_numeric_end --- forget what opt_numeric_start() and the walks found.
+ */
+
+static void
+opt_numeric_end(void)
+{
+	if (opt_params_start != NULL)
+		efree(opt_params_start);
+	if (opt_all_params != NULL)
+		efree(opt_all_params);
+	opt_params_start = NULL;
+	opt_all_params = NULL;
+	opt_all_params_count = opt_all_params_size = 0;
+	opt_func = NULL;
+	opt_params = NULL;
+	opt_free_table(& opt_vars);
+}
+
+/*
+ * opt_field_uses --- note the fields the instruction at pc can use, for
+ *	field projection; prev is the one before it.  If they are all given
+ *	as constants, and neither the fields other than $0 nor NF are ever
+ *	assigned to, the field splitting need not keep the others.  Return
+ *	false if it must.
+ */
+
+#define OPT_MAX_PROJECT	256	/* highest field number worth projecting */
+
+static bool
+opt_field_uses(INSTRUCTION *pc, INSTRUCTION *prev, bool *wanted, long *max)
+{
+	long num;
+
+	switch (pc->opcode) {
+	case Op_field_spec:
+		if (prev == NULL || ! opt_field_num(prev, & num)
+				|| num > OPT_MAX_PROJECT)
+			return false;	/* $i or $NF */
+		wanted[num] = true;
+		if (num > *max)
+			*max = num;
+		return true;
+
+	case Op_field_spec_lhs:
+	case Op_store_field:
+	case Op_store_field_exp:
+	case Op_field_assign:
+		/* $0 may be replaced, the others need all of $0 rebuilt */
+		return (prev != NULL && opt_field_num(prev, & num) && num == 0);
+
+	case Op_push:
+		return true;
+
+	default:
+		break;
+	}
+	/* NF changed, or SYMTAB which could change it */
+	return ! (pc->d.dn == NF_node || pc->x.xn == NF_node
+		  || pc->d.dn == symbol_table || pc->x.xn == symbol_table);
+}
+
+/*
+ * optimize_program --- optimize the program and all the functions.
+ *
+ * The passes go over each list of instructions in turn and do as much as
+ * they can with it while it is still in the cache.  For large programs,
+ * walking the instructions is what takes the time.
+ */
+
+static void
+optimize_program(INSTRUCTION *code)
+{
+	NODE **funcs = func_defs;
+	INSTRUCTION **lists;
+	NODE *argv_node;
+	SRCFILE *s;
+	bool vars_ok, fields_ok = true;
+	bool any_fields, changed;
+	bool *wanted;
+	long max = 0;
+	INSTRUCTION *pc, *prev;
+	int i, count, nfuncs = func_defs_count;
+
+	/* the main program, then the function bodies */
+	emalloc(lists, INSTRUCTION **, (nfuncs + 2) * sizeof(INSTRUCTION *));
+	lists[0] = code;
+	for (i = 0; i < nfuncs; i++)
+		lists[i + 1] = funcs[i]->code_ptr->nexti;
+	lists[nfuncs + 1] = NULL;
+
+	/* SYMTAB, ARGV and extensions can change any variable */
+	argv_node = lookup("ARGV");
+	vars_ok = (argv_node != NULL && argv_node->type == Node_var_array);
+	for (s = srcfiles->next; s != srcfiles; s = s->next)
+		if (s->stype == SRC_EXTLIB)
+			vars_ok = fields_ok = false;
+
+	/*
+	 * First find out what the whole program does, and do what needs
+	 * only the list at hand.  The first opt_numeric_list() walk over a
+	 * list knows all the global variables it uses.
+	 */
+	ezalloc(wanted, bool *, (OPT_MAX_PROJECT + 1) * sizeof(bool));
+	opt_numeric_start(nfuncs);
+	for (i = 0; lists[i] != NULL; i++) {
+		opt_free_table(& opt_refs);
+		if (i == 0)
+			opt_main_refs();
+		count = 0;
+		any_fields = false;
+		for (prev = NULL, pc = lists[i]; pc != NULL; prev = pc, pc = pc->nexti) {
+			count++;
+			opt_collect_refs(pc);
+			if (vars_ok)
+				opt_collect_setvars(pc);
+			opt_collect_vars(pc);
+			if (fields_ok)
+				fields_ok = opt_field_uses(pc, prev, wanted, & max);
+			if (pc->opcode == Op_field_spec)
+				any_fields = true;
+			if (i > 0)
+				mark_tail_call(pc, funcs[i - 1]);
+		}
+		if (! do_lint && any_fields)
+			opt_reuse_fields(lists[i]);
+		if (i > 0)
+			inline_note_size(funcs[i - 1], count);
+		(void) opt_numeric_list(lists, funcs, i, false);
+	}
+	if (vars_ok)
+		vars_ok = opt_check_setvars(lists, argv_node);
+	if (fields_ok)
+		set_field_projection(wanted, max);
+	else
+		efree(wanted);
+
+	/*
+	 * Then use the numeric variables, checking them again; most programs
+	 * need no further walks.  Inline last, after the rest is done with
+	 * the list.
+	 */
+	changed = false;
+	for (i = 0; lists[i] != NULL; i++) {
+		opt_list_refs(lists[i], i == 0);
+		for (pc = lists[i]; pc != NULL; pc = pc->nexti)
+			opt_fold_condition(pc, vars_ok);
+		changed |= opt_numeric_list(lists, funcs, i, true);
+		if (! do_lint)
+			inline_calls(lists[i], (i == 0) ? NULL
+					: funcs[i - 1]->code_ptr->source_file);
+	}
+	while (changed) {
+		changed = false;
+		for (i = 0; lists[i] != NULL; i++) {
+			opt_list_refs(lists[i], i == 0);
+			changed |= opt_numeric_list(lists, funcs, i, true);
+		}
+	}
+	inline_names = 0;
+	opt_free_table(& opt_setvars);
+	opt_numeric_end();
+	opt_free_table(& opt_refs);
+
+	efree(lists);
+}
+
+/* mk_getline --- make instructions for getline */
+
+static INSTRUCTION *
+mk_getline(INSTRUCTION *op, INSTRUCTION *var, INSTRUCTION *redir, int redirtype)
+{
+	INSTRUCTION *ip;
+	INSTRUCTION *tp;
+	INSTRUCTION *asgn = NULL;
+
+	/*
+	 *  getline [var] < [file]
+	 *
+	 *  [ file (simp_exp)]
+	 *  [ [ var ] ]
+	 *  [ Op_K_getline_redir|NULL|redir_type|into_var]
+	 *  [ [var_assign] ]
+	 *
+	 */
+
+	if (redir == NULL) {
+		int sline = op->source_line;
+		bcfree(op);
+		op = bcalloc(Op_K_getline, 2, sline);
+		(op + 1)->target_endfile = ip_endfile;
+		(op + 1)->target_beginfile = ip_beginfile;
+	}
+
+	if (var != NULL) {
+		tp = make_assignable(var->lasti);
+		assert(tp != NULL);
+
+		/* check if we need after_assign bytecode */
+		if (tp->opcode == Op_push_lhs
+				&& tp->memory->type == Node_var
+				&& tp->memory->var_assign
+		) {
+			asgn = instruction(Op_var_assign);
+			asgn->assign_ctxt = op->opcode;
+			asgn->assign_var = tp->memory->var_assign;
+		} else if (tp->opcode == Op_field_spec_lhs) {
+			asgn = instruction(Op_field_assign);
+			asgn->assign_ctxt = op->opcode;
+			asgn->field_assign = (Func_ptr) 0;   /* determined at run time */
+			tp->target_assign = asgn;
+		} else if (tp->opcode == Op_subscript_lhs) {
+			asgn = instruction(Op_subscript_assign);
+			asgn->assign_ctxt = op->opcode;
+		}
+
+		if (redir != NULL) {
+			ip = list_merge(redir, var);
+			(void) list_append(ip, op);
+		} else
+			ip = list_append(var, op);
+	} else if (redir != NULL)
+		ip = list_append(redir, op);
+	else
+		ip = list_create(op);
+	op->into_var = (var != NULL);
+	op->redir_type = (redir != NULL) ? redirtype : redirect_none;
+
+	return (asgn == NULL ? ip : list_append(ip, asgn));
+}
+
+
+/* mk_for_loop --- for loop bytecodes */
+
+static INSTRUCTION *
+mk_for_loop(INSTRUCTION *forp, INSTRUCTION *init, INSTRUCTION *cond,
+				INSTRUCTION *incr, INSTRUCTION *body)
+{
+	/*
+	 *   ------------------------
+	 *        init                 (may be NULL)
+	 *   ------------------------
+	 * x:
+	 *        cond                 (Op_no_op if NULL)
+	 *   ------------------------
+	 *    [ Op_jmp_false tb      ]
+	 *   ------------------------
+	 *        body                 (may be NULL)
+	 *   ------------------------
+	 * tc:
+	 *    incr                      (may be NULL)
+	 *    [ Op_jmp x             ]
+	 *   ------------------------
+	 * tb:[ Op_no_op             ]
+	 */
+
+	INSTRUCTION *ip, *tbreak, *tcont;
+	INSTRUCTION *jmp;
+	INSTRUCTION *pp_cond;
+	INSTRUCTION *ret;
+
+	tbreak = instruction(Op_no_op);
+
+	if (cond != NULL) {
+		add_lint(cond, LINT_assign_in_cond);
+		pp_cond = cond->nexti;
+		ip = cond;
+		(void) list_append(ip, instruction(Op_jmp_false));
+		ip->lasti->target_jmp = tbreak;
+	} else {
+		pp_cond = instruction(Op_no_op);
+		ip = list_create(pp_cond);
+	}
+
+	if (init != NULL)
+		ip = list_merge(init, ip);
+
+	if (do_pretty_print) {
+		(void) list_append(ip, instruction(Op_exec_count));
+		(forp + 1)->forloop_cond = pp_cond;
+		(forp + 1)->forloop_body = ip->lasti;
+	}
+
+	if (body != NULL)
+		(void) list_merge(ip, body);
+
+	jmp = instruction(Op_jmp);
+	jmp->target_jmp = pp_cond;
+	if (incr == NULL)
+		tcont = jmp;
+	else {
+		tcont = incr->nexti;
+		(void) list_merge(ip, incr);
+	}
+
+	(void) list_append(ip, jmp);
+	ret = list_append(ip, tbreak);
+	fix_break_continue(ret, tbreak, tcont);
+
+	if (do_pretty_print) {
+		forp->target_break = tbreak;
+		forp->target_continue = tcont;
+		ret = list_prepend(ret, forp);
+	}
+	/* else
+		forp is NULL */
+
+	return ret;
+}
+
+/* add_lint --- add lint warning bytecode if needed */
+
+static void
+add_lint(INSTRUCTION *list, LINTTYPE linttype)
+{
+#ifndef NO_LINT
+	INSTRUCTION *ip;
+	bool no_effect = true;
+
+	switch (linttype) {
+	case LINT_assign_in_cond:
+		ip = list->lasti;
+		if (ip->opcode == Op_var_assign || ip->opcode == Op_field_assign) {
+			assert(ip != list->nexti);
+			for (ip = list->nexti; ip->nexti != list->lasti; ip = ip->nexti)
+				;
+		}
+
+		if (ip->opcode == Op_assign || ip->opcode == Op_assign_concat) {
+			list_append(list, instruction(Op_lint));
+			list->lasti->lint_type = linttype;
+		}
+		break;
+
+	case LINT_no_effect:
+		if (list->lasti->opcode == Op_pop && list->nexti != list->lasti) {
+			int line = 0;
+
+			// Get down to the last instruction ...
+			for (ip = list->nexti; ip->nexti != list->lasti; ip = ip->nexti) {
+				// ... along the way track line numbers, we will use the line
+				// closest to the opcode if that opcode doesn't have one
+				if (ip->source_line != 0)
+					line = ip->source_line;
+
+				// And check each opcode for no effect
 				no_effect = no_effect && isnoeffect(ip->opcode);
 			}
 
@@ -6914,6 +8496,9 @@ qualify_name(const char *name, size_t len)
 	if (strchr(name, ':') != NULL)	// already qualified
 		return estrdup(name, len);
 
+	if (current_namespace == awk_namespace)	// nothing to add
+		return estrdup(name, len);
+
 	NODE *p = lookup(name);
 	if (p != NULL && p->type == Node_param_list)
 		return estrdup(name, len);
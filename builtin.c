@@ -410,6 +410,7 @@ do_index(int nargs)
 	size_t l1, l2;
 	long ret;
 	bool do_single_byte = false;
+	bool byte_pos = false;
 	mbstate_t mbs1, mbs2;
 
 	check_exact_args(nargs, "index", 2);
@@ -447,7 +448,23 @@ do_index(int nargs)
 		goto out;
 	}
 
-	if (gawk_mb_cur_max > 1) {
+	/*
+	 * Between two all-ASCII strings bytes are characters, so search
+	 * the bytes.  Ignoring case too, if the locale folds ASCII plainly.
+	 */
+	if (gawk_mb_cur_max > 1 && str_is_ascii(s1) && str_is_ascii(s2)
+	    && (! IGNORECASE || ascii_case_is_plain()))
+		do_single_byte = true;
+	else if (gawk_mb_cur_max > 1 && ! IGNORECASE
+		 && (! mb_string(s1) || has_charidx(s1))
+		 && (! mb_string(s2) || has_charidx(s2))) {
+		/*
+		 * In valid UTF-8 the bytes match where the characters do,
+		 * so search the bytes and convert the position.
+		 */
+		do_single_byte = true;
+		byte_pos = ((s1->flags & CHARIDX) != 0);
+	} else if (gawk_mb_cur_max > 1) {
 		s1 = force_wstring(s1);
 		s2 = force_wstring(s2);
 		/*
@@ -493,6 +510,8 @@ do_index(int nargs)
 			if (*p1 == *p2
 			    && (l2 == 1 || (l2 > 0 && memcmp(p1, p2, l2) == 0))) {
 				ret = 1 + s1->stlen - l1;
+				if (byte_pos)
+					ret = 1 + charidx_char_offset(s1, ret - 1);
 				break;
 			}
 			if (! do_single_byte && gawk_mb_cur_max > 1) {
@@ -614,7 +633,9 @@ do_length(int nargs)
 		lintwarn(_("%s: received non-string argument"), "length");
 	tmp = force_string(tmp);
 
-	if (gawk_mb_cur_max > 1) {
+	if (mb_string(tmp) && has_charidx(tmp))
+		len = tmp->wstlen;
+	else if (mb_string(tmp)) {
 		tmp = force_wstring(tmp);
 		len = tmp->wstlen;
 		/*
@@ -682,6 +703,7 @@ do_substr(int nargs)
 	size_t length = 0;
 	double d_index = 0, d_length = 0;
 	size_t src_len;
+	bool mb, cidx;
 
 	check_args_min_max(nargs, "substr", 2, 3);
 
@@ -753,11 +775,19 @@ do_substr(int nargs)
 	else
 		indx = SIZE_MAX;
 
+	/*
+	 * An all-ASCII string can be indexed by bytes, and valid UTF-8
+	 * through its character index.  Others need the wide string.
+	 */
+	mb = mb_string(t1);
+	cidx = (mb && has_charidx(t1));
+
 	if (nargs == 2) {	/* third arg. missing */
 		/* use remainder of string */
 		length = t1->stlen - indx;	/* default to bytes */
-		if (gawk_mb_cur_max > 1) {
-			t1 = force_wstring(t1);
+		if (mb) {
+			if (! cidx)
+				t1 = force_wstring(t1);
 			if (t1->wstlen > 0)	/* use length of wide char string if we have one */
 				length = t1->wstlen - indx;
 		}
@@ -773,8 +803,9 @@ do_substr(int nargs)
 	}
 
 	/* get total len of input string, for following checks */
-	if (gawk_mb_cur_max > 1) {
-		t1 = force_wstring(t1);
+	if (mb) {
+		if (! cidx)
+			t1 = force_wstring(t1);
 		src_len = t1->wstlen;
 	} else
 		src_len = t1->stlen;
@@ -794,11 +825,17 @@ do_substr(int nargs)
 		length = src_len - indx;
 	}
 
-	/* force_wstring() already called */
-	if (gawk_mb_cur_max == 1 || t1->wstlen == t1->stlen)
+	if (cidx) {
+		size_t start = charidx_byte_offset(t1, indx);
+
+		r = make_str_view(t1, t1->stptr + start,
+				charidx_byte_offset(t1, indx + length) - start);
+	} else if (! mb || t1->wstlen == t1->stlen) {
+		/* force_wstring() already called */
 		/* single byte case */
-		r = make_string(t1->stptr + indx, length);
-	else {
+		r = make_str_view(t1, t1->stptr + indx, length);
+		r->flags |= (t1->flags & ASCIISTR);
+	} else {
 		/* multibyte case, more work */
 		size_t result;
 		char32_t *wp;
@@ -1114,6 +1151,52 @@ do_system(int nargs)
 	return make_number(ret);
 }
 
+/*
+ * print_integer --- true if n is a plain integer with no string value
+ *	yet.  r_format_val() would just give it "%ld" whatever OFMT is,
+ *	so print writes the digits itself.
+ */
+
+static inline bool
+print_integer(const NODE *n)
+{
+	return n->type == Node_val
+		&& (n->flags & (NUMBER|STRCUR|MPFN|MPZN)) == NUMBER
+		&& n->numbr > (double) LONG_MIN && n->numbr < (double) LONG_MAX
+		&& (double) (long) n->numbr == n->numbr;
+}
+
+/*
+ * print_gather --- should print gather len bytes of output into one
+ *	buffer, so that the statement is a single write?  Anything bigger
+ *	than PRINT_GATHER_MAX is written piece by piece, and so is output
+ *	that an extension's output wrapper sees write by write.
+ */
+
+#define PRINT_GATHER_MAX	(64 * 1024)
+
+static inline bool
+print_gather(struct redirect *rp, size_t len)
+{
+	return len <= PRINT_GATHER_MAX
+		&& (rp == NULL || rp->output.gawk_fwrite == gawk_fwrite);
+}
+
+/* print_buffer --- return a buffer of at least len bytes for print_gather */
+
+static char *
+print_buffer(size_t len)
+{
+	static char *buf = NULL;
+	static size_t bufsize = 0;
+
+	if (len > bufsize) {
+		bufsize = (len < 1024) ? 1024 : len;
+		erealloc(buf, char *, bufsize);
+	}
+	return buf;
+}
+
 /* do_print --- print items, separated by OFS, terminated with ORS */
 
 void
@@ -1125,6 +1208,7 @@ do_print(int nargs, int redirtype)
 	int i;
 	NODE *redir_exp = NULL;
 	NODE *tmp = NULL;
+	size_t len;
 
 	assert(nargs <= max_args);
 
@@ -1161,6 +1245,8 @@ do_print(int nargs, int redirtype)
 				DEREF(args_array[i]);
 			fatal(_("attempt to use array `%s' in a scalar context"), array_vname(tmp));
 		}
+		if (print_integer(tmp))
+			continue;
 		// Let force_string_ofmt handle checking if things
 		// are already valid.
 		args_array[i] = force_string_ofmt(tmp);
@@ -1179,16 +1265,61 @@ do_print(int nargs, int redirtype)
 		return;
 	}
 
+	len = ORSlen;
 	for (i = nargs; i > 0; i--) {
-		efwrite(args_array[i]->stptr, sizeof(char), args_array[i]->stlen, fp, "print", rp, false);
-		DEREF(args_array[i]);
-		if (i != 1 && OFSlen > 0)
-			efwrite(OFS, sizeof(char), (size_t) OFSlen,
-				fp, "print", rp, false);
+		if (print_integer(args_array[i]))
+			len += ITOA_BUFSIZE;
+		else
+			len += args_array[i]->stlen;
+		if (i != 1)
+			len += OFSlen;
+	}
+
+	if (print_gather(rp, len)) {
+		char *buf = print_buffer(len);
+		char *cp = buf;
+
+		for (i = nargs; i > 0; i--) {
+			if (print_integer(args_array[i])) {
+				char digits[ITOA_BUFSIZE];
+				char *dp;
 
+				dp = fast_itoa((long) args_array[i]->numbr, digits + sizeof(digits));
+				memcpy(cp, dp, digits + sizeof(digits) - dp);
+				cp += digits + sizeof(digits) - dp;
+			} else {
+				memcpy(cp, args_array[i]->stptr, args_array[i]->stlen);
+				cp += args_array[i]->stlen;
+			}
+			DEREF(args_array[i]);
+			if (i != 1 && OFSlen > 0) {
+				memcpy(cp, OFS, OFSlen);
+				cp += OFSlen;
+			}
+		}
+		if (ORSlen > 0) {
+			memcpy(cp, ORS, ORSlen);
+			cp += ORSlen;
+		}
+		efwrite(buf, sizeof(char), cp - buf, fp, "print", rp, ORSlen > 0);
+	} else {
+		for (i = nargs; i > 0; i--) {
+			if (print_integer(args_array[i])) {
+				char digits[ITOA_BUFSIZE];
+				char *cp;
+
+				cp = fast_itoa((long) args_array[i]->numbr, digits + sizeof(digits));
+				efwrite(cp, sizeof(char), digits + sizeof(digits) - cp, fp, "print", rp, false);
+			} else
+				efwrite(args_array[i]->stptr, sizeof(char), args_array[i]->stlen, fp, "print", rp, false);
+			DEREF(args_array[i]);
+			if (i != 1 && OFSlen > 0)
+				efwrite(OFS, sizeof(char), (size_t) OFSlen,
+					fp, "print", rp, false);
+		}
+		if (ORSlen > 0)
+			efwrite(ORS, sizeof(char), (size_t) ORSlen, fp, "print", rp, true);
 	}
-	if (ORSlen > 0)
-		efwrite(ORS, sizeof(char), (size_t) ORSlen, fp, "print", rp, true);
 
 	if (rp != NULL && (rp->flag & RED_TWOWAY) != 0)
 		rp->output.gawk_fflush(rp->output.fp, rp->output.opaque);
@@ -1241,10 +1372,18 @@ do_print_rec(int nargs, int redirtype)
 	if (do_lint && (f0->flags & NULL_FIELD) != 0)
 		lintwarn(_("reference to uninitialized field `$%d'"), 0);
 
-	efwrite(f0->stptr, sizeof(char), f0->stlen, fp, "print", rp, false);
+	if (ORSlen > 0 && print_gather(rp, f0->stlen + ORSlen)) {
+		char *buf = print_buffer(f0->stlen + ORSlen);
+
+		memcpy(buf, f0->stptr, f0->stlen);
+		memcpy(buf + f0->stlen, ORS, ORSlen);
+		efwrite(buf, sizeof(char), f0->stlen + ORSlen, fp, "print", rp, true);
+	} else {
+		efwrite(f0->stptr, sizeof(char), f0->stlen, fp, "print", rp, false);
 
-	if (ORSlen > 0)
-		efwrite(ORS, sizeof(char), (size_t) ORSlen, fp, "print", rp, true);
+		if (ORSlen > 0)
+			efwrite(ORS, sizeof(char), (size_t) ORSlen, fp, "print", rp, true);
+	}
 
 	if (rp != NULL && (rp->flag & RED_TWOWAY) != 0)
 		rp->output.gawk_fflush(rp->output.fp, rp->output.opaque);
@@ -1330,7 +1469,8 @@ do_tolower(int nargs)
 	t1 = force_string(t1);
 	t2 = make_string(t1->stptr, t1->stlen);
 
-	if (gawk_mb_cur_max == 1) {
+	if (gawk_mb_cur_max == 1
+	    || (str_is_ascii(t1) && ascii_case_is_plain())) {
 		unsigned char *cp, *cp2;
 
 		for (cp = (unsigned char *)t2->stptr,
@@ -1338,6 +1478,7 @@ do_tolower(int nargs)
 			cp < cp2; cp++)
 			if (isupper(*cp))
 				*cp = tolower(*cp);
+		t2->flags |= (t1->flags & ASCIISTR);
 	} else {
 		force_wstring(t2);
 		wide_tolower(t2->wstptr, t2->wstlen);
@@ -1363,7 +1504,8 @@ do_toupper(int nargs)
 	t1 = force_string(t1);
 	t2 = make_string(t1->stptr, t1->stlen);
 
-	if (gawk_mb_cur_max == 1) {
+	if (gawk_mb_cur_max == 1
+	    || (str_is_ascii(t1) && ascii_case_is_plain())) {
 		unsigned char *cp, *cp2;
 
 		for (cp = (unsigned char *)t2->stptr,
@@ -1371,6 +1513,7 @@ do_toupper(int nargs)
 			cp < cp2; cp++)
 			if (islower(*cp))
 				*cp = toupper(*cp);
+		t2->flags |= (t1->flags & ASCIISTR);
 	} else {
 		force_wstring(t2);
 		wide_toupper(t2->wstptr, t2->wstlen);
@@ -1601,9 +1744,15 @@ do_match(int nargs)
 	rstart = research(rp, t1->stptr, 0, t1->stlen, RE_NEED_START|RE_NEED_SUB);
 	if (rstart >= 0) {	/* match succeeded */
 		size_t *wc_indices = NULL;
+		bool cidx = false;
 
 		rlength = REEND(rp, t1->stptr) - RESTART(rp, t1->stptr);	/* byte length */
-		if (gawk_mb_cur_max > 1) {
+		if (mb_string(t1) && has_charidx(t1)) {
+			cidx = true;
+			rlength = charidx_char_offset(t1, rstart + rlength)
+					- charidx_char_offset(t1, rstart);
+			rstart = charidx_char_offset(t1, rstart);
+		} else if (mb_string(t1)) {
 			t1 = str2wstr(t1, & wc_indices);
 			rlength = wc_indices[rstart + rlength] - wc_indices[rstart];
 			rstart = wc_indices[rstart];
@@ -1628,7 +1777,10 @@ do_match(int nargs)
 					start = t1->stptr + s;
 					subpat_start = s;
 					subpat_len = len = SUBPATEND(rp, t1->stptr, ii) - s;
-					if (gawk_mb_cur_max > 1) {
+					if (cidx) {
+						subpat_start = charidx_char_offset(t1, s);
+						subpat_len = charidx_char_offset(t1, s + len) - subpat_start;
+					} else if (wc_indices != NULL) {
 						subpat_start = wc_indices[s];
 						subpat_len = wc_indices[s + len] - subpat_start;
 					}
@@ -3343,7 +3495,22 @@ gawk_system(const char *command)
 	qstat = signal(SIGQUIT, SIG_IGN);
 #endif
 
-	if ((childpid = fork()) == 0) {
+#ifdef HAVE_SIGPROCMASK
+	sigset_t dflt;
+
+	sigemptyset(& dflt);
+	if (old_int_action.sa_handler != SIG_IGN)
+		sigaddset(& dflt, SIGINT);
+	if (old_quit_action.sa_handler != SIG_IGN)
+		sigaddset(& dflt, SIGQUIT);
+	int close_fds[] = { -1 };
+
+	if ((childpid = spawn_shell(command, -1, -1, close_fds, & oldset, & dflt)) < 0)
+		childpid = fork();
+#else
+	childpid = fork();
+#endif
+	if (childpid == 0) {
 		// child
 		set_sigpipe_to_default();
 		// in the child, restore defaults
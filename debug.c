@@ -3983,10 +3983,35 @@ print_instruction(INSTRUCTION *pc, Func_print print_func, FILE *fp, int in_dump)
 
 	case Op_indirect_func_call:
 	case Op_func_call:
+	case Op_tail_call:
 		print_func(fp, "[func_name = %s] [arg_count = %ld]\n",
 		                pc->func_name, (pc + 1)->expr_count);
 		break;
 
+	case Op_func_call_inline:
+		print_func(fp, "[func_name = %s] [arg_count = %ld] [inline_last = " PTRFMT "]\n",
+		                pc->func_name, (pc + 1)->expr_count, (pc + 1)->inline_last);
+		break;
+
+	case Op_inline_return:
+		print_func(fp, "[arg_count = %ld] [target_jmp = " PTRFMT "]\n",
+		                pc->expr_count, pc->target_jmp);
+		break;
+
+	case Op_push_stack:
+		print_func(fp, "[stack_offset = %ld]\n", pc->stack_offset);
+		break;
+
+	case Op_cmp_num:
+		print_func(fp, "[cmp_type = %ld]\n", pc->cmp_type);
+		break;
+
+	case Op_jmp_cmp_true:
+	case Op_jmp_cmp_false:
+		print_func(fp, "[cmp_type = %ld] [target_jmp = " PTRFMT "]\n",
+		                pc->cmp_type, pc->target_jmp);
+		break;
+
 	case Op_K_nextfile:
 		print_func(fp, "[target_newfile = " PTRFMT "] [target_endfile = " PTRFMT "]\n",
 		                pc->target_newfile, pc->target_endfile);
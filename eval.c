@@ -313,6 +313,7 @@ static struct optypetab {
 	{ "Op_greater", " > " },
 	{ "Op_leq", " <= " },
 	{ "Op_geq", " >= " },
+	{ "Op_cmp_num", NULL },
 	{ "Op_match", " ~ " },
 	{ "Op_match_rec", NULL },
 	{ "Op_nomatch", " !~ " },
@@ -340,6 +341,9 @@ static struct optypetab {
 	{ "Op_in_array", " in " },
 	{ "Op_func_call", NULL },
 	{ "Op_indirect_func_call", NULL },
+	{ "Op_func_call_inline", NULL },
+	{ "Op_inline_return", "return" },
+	{ "Op_tail_call", NULL },
 	{ "Op_push", NULL },
 	{ "Op_push_arg", NULL },
 	{ "Op_push_arg_untyped", NULL },
@@ -347,6 +351,7 @@ static struct optypetab {
 	{ "Op_push_re", NULL },
 	{ "Op_push_array", NULL },
 	{ "Op_push_param", NULL },
+	{ "Op_push_stack", NULL },
 	{ "Op_push_lhs", NULL },
 	{ "Op_subscript_lhs", "[]" },
 	{ "Op_field_spec_lhs", "$" },
@@ -355,6 +360,8 @@ static struct optypetab {
 	{ "Op_jmp", NULL },
 	{ "Op_jmp_true", NULL },
 	{ "Op_jmp_false", NULL },
+	{ "Op_jmp_cmp_true", NULL },
+	{ "Op_jmp_cmp_false", NULL },
 	{ "Op_get_record", NULL },
 	{ "Op_newfile", NULL },
 	{ "Op_arrayfor_init", NULL },
@@ -460,6 +467,10 @@ flags2str(int flagval)
 		{ REGEX, "REGEX" },
 		{ CONVFMT_FMT, "CONVFMT_FMT" },
 		{ OFMT_FMT, "OFMT_FMT" },
+		{ ASCIISTR, "ASCIISTR" },
+		{ CHARIDX, "CHARIDX" },
+		{ STRVIEW, "STRVIEW" },
+		{ STRCAP, "STRCAP" },
 		{ 0,	NULL },
 	};
 
@@ -516,6 +527,19 @@ posix_compare(NODE *s1, NODE *s2)
 {
 	int ret = 0;
 
+	if (   s1->stptr <= s2->stptr + s2->stlen
+	    && s2->stptr <= s1->stptr + s1->stlen) {
+		/*
+		 * The texts overlap, as for a field and $0, so the
+		 * terminators written below would change one of them.
+		 */
+		NODE *t = make_string(s2->stptr, s2->stlen);
+
+		ret = posix_compare(s1, t);
+		unref(t);
+		return ret;
+	}
+
 #ifdef __MINGW32__
 	if (gawk_mb_cur_max == 1) {
 #endif
@@ -627,16 +651,15 @@ cmp_nodes(NODE *t1, NODE *t2, bool use_strcmp)
 	if (IGNORECASE) {
 		const unsigned char *cp1 = (const unsigned char *) t1->stptr;
 		const unsigned char *cp2 = (const unsigned char *) t2->stptr;
-		char save1 = t1->stptr[t1->stlen];
-		char save2 = t2->stptr[t2->stlen];
-
 
 		if (gawk_mb_cur_max > 1) {
-			t1->stptr[t1->stlen] = t2->stptr[t2->stlen] = '\0';
+			/*
+			 * No terminators: strncasecmpmbs() stops after l bytes,
+			 * and writing them could change the other string
+			 * when the two overlap.
+			 */
 			ret = strncasecmpmbs((const unsigned char *) cp1,
 					     (const unsigned char *) cp2, l);
-			t1->stptr[t1->stlen] = save1;
-			t2->stptr[t2->stlen] = save2;
 		} else {
 			/* Could use tolower() here; see discussion above. */
 			for (ret = 0; l-- > 0 && ret == 0; cp1++, cp2++)
@@ -912,6 +935,7 @@ fmt_index(NODE *n)
 	if (fmt_list == NULL)
 		emalloc(fmt_list, NODE **, fmt_num*sizeof(*fmt_list));
 	n = force_string(n);
+	settle_string(n);
 
 	save = n->stptr[n->stlen];
 	n->stptr[n->stlen] = '\0';
@@ -1009,6 +1033,7 @@ set_TEXTDOMAIN()
 	NODE *tmp;
 
 	tmp = TEXTDOMAIN_node->var_value = force_string(TEXTDOMAIN_node->var_value);
+	settle_string(tmp);
 	TEXTDOMAIN = tmp->stptr;
 	/*
 	 * Note: don't call textdomain(); this value is for
@@ -1286,24 +1311,16 @@ calc_exp(double x1, double x2)
 }
 
 
-/* setup_frame --- setup new frame for function call */
+/* setup_params --- bind the arguments on the stack to the locals in sp */
 
-static INSTRUCTION *
-setup_frame(INSTRUCTION *pc)
+static void
+setup_params(NODE *f, NODE **sp, int arg_count)
 {
-	NODE *r = NULL;
-	NODE *m, *f, *fp;
-	NODE **sp = NULL;
-	int pcount, arg_count, i, j;
+	NODE *r, *m, *fp;
+	int pcount, i, j;
 
-	f = pc->func_body;
 	pcount = f->param_cnt;
 	fp = f->fparms;
-	arg_count = (pc + 1)->expr_count;
-
-	if (pcount > 0) {
-		ezalloc(sp, NODE **, pcount * sizeof(NODE *));
-	}
 
 	/* check for extra args */
 	if (arg_count > pcount) {
@@ -1318,9 +1335,8 @@ setup_frame(INSTRUCTION *pc)
 	}
 
 	for (i = 0, j = arg_count - 1; i < pcount; i++, j--) {
-		getnode(r);
+		r = sp[i];
 		memset(r, 0, sizeof(NODE));
-		sp[i] = r;
 
 		if (i >= arg_count) {
 			/* local variable */
@@ -1392,6 +1408,46 @@ setup_frame(INSTRUCTION *pc)
 	}
 
 	stack_adj(-arg_count);	/* adjust stack pointer */
+}
+
+
+/*
+ * Frames of returning functions, together with their array of local
+ * variable nodes, are kept on a per-function free list, so that calls
+ * don't have to go to the allocator for them.  Limit the number of
+ * frames kept, so that a single very deep recursion doesn't hold on
+ * to all of its memory forever.
+ */
+
+#define MAX_POOLED_FRAMES	64
+
+/* setup_frame --- setup new frame for function call */
+
+static INSTRUCTION *
+setup_frame(INSTRUCTION *pc)
+{
+	NODE *r, *f;
+	NODE *frame;
+	NODE **sp = NULL;
+	int pcount, i;
+
+	f = pc->func_body;
+	pcount = f->param_cnt;
+
+	if ((frame = f->frame_pool) != NULL) {
+		f->frame_pool = frame->next_frame;
+		f->frame_pool_size--;
+		sp = frame->stack;
+	} else {
+		getnode(frame);
+		if (pcount > 0) {
+			emalloc(sp, NODE **, pcount * sizeof(NODE *));
+			for (i = 0; i < pcount; i++)
+				getnode(sp[i]);
+		}
+	}
+
+	setup_params(f, sp, (pc + 1)->expr_count);
 
 	if (pc->opcode == Op_indirect_func_call) {
 		r = POP();	/* indirect var */
@@ -1407,7 +1463,7 @@ setup_frame(INSTRUCTION *pc)
 	PUSH(frame_ptr);
 
 	/* setup new frame */
-	getnode(frame_ptr);
+	frame_ptr = frame;
 	memset(frame_ptr, '\0', sizeof(NODE));
 	frame_ptr->type = Node_frame;
 	frame_ptr->stack = sp;
@@ -1420,6 +1476,79 @@ setup_frame(INSTRUCTION *pc)
 }
 
 
+/*
+ * tail_call --- `return f(...)' inside f: rebind the locals of the
+ *	current frame to the new arguments instead of pushing a new frame.
+ *	Returns NULL if that isn't possible, and a real call has to be made.
+ */
+
+static INSTRUCTION *
+tail_call(INSTRUCTION *pc)
+{
+	NODE *r, *m, *f;
+	NODE **sp;
+	int pcount, arg_count, i, j;
+
+	f = pc->func_body;
+	pcount = f->param_cnt;
+	arg_count = (pc + 1)->expr_count;
+	sp = frame_ptr->stack;
+
+	if (do_debug || frame_ptr->func_node != f)
+		return NULL;
+
+	/* anything between the saved frame and the arguments, e.g. for-in loop state? */
+	if (stack_ptr - arg_count != stack_bottom + frame_ptr->prev_frame_size)
+		return NULL;
+
+	for (j = 0; j < arg_count; j++) {
+		m = PEEK(j);
+		if (m->type == Node_val)
+			continue;
+		if (m->type == Node_param_list) {
+			m = GET_PARAM(m->param_cnt);
+			(stack_ptr - j)->rptr = m;
+		}
+		/* a subarray of one of our local arrays goes away with it */
+		for (r = m; r->type == Node_var_array && r->parent_array != NULL; r = r->parent_array)
+			continue;
+		if (r != m) {
+			for (i = 0; i < pcount; i++)
+				if (r == sp[i])
+					return NULL;
+			continue;
+		}
+
+		for (i = 0; i < pcount; i++)
+			if (m == sp[i])
+				break;
+		if (i == pcount)
+			continue;
+
+		/*
+		 * One of our own locals.  An array parameter can be passed on
+		 * by referring to whatever it refers to; a local array or an
+		 * untyped local needs to outlive this call.
+		 */
+		if (m->type != Node_array_ref)
+			return NULL;
+		(stack_ptr - j)->rptr = m->prev_array;
+	}
+
+	for (i = 0; i < pcount; i++) {
+		r = sp[i];
+		if (r->type == Node_var)
+			DEREF(r->var_value);
+		else if (r->type == Node_var_array)
+			assoc_clear(r);
+	}
+
+	setup_params(f, sp, arg_count);
+
+	return f->code_ptr;
+}
+
+
 /* restore_frame --- clean up the stack and update frame */
 
 static INSTRUCTION *
@@ -1430,26 +1559,37 @@ restore_frame(NODE *fp)
 	int n;
 	NODE *func;
 	INSTRUCTION *ri;
+	bool keep;
 
 	func = frame_ptr->func_node;
 	n = func->param_cnt;
 	sp = frame_ptr->stack;
 
+	/* the debugger's eval command resizes the frame, don't reuse it */
+	keep = (! do_debug && func->frame_pool_size < MAX_POOLED_FRAMES);
+
 	for (; n > 0; n--) {
 		r = *sp++;
 		if (r->type == Node_var)     /* local variable */
 			DEREF(r->var_value);
 		else if (r->type == Node_var_array)     /* local array */
 			assoc_clear(r);
-		freenode(r);
+		if (! keep)
+			freenode(r);
 	}
 
-	if (frame_ptr->stack != NULL)
-		efree(frame_ptr->stack);
 	ri = frame_ptr->reti;     /* execution in calling frame
 	                           * resumes from ri->nexti.
 	                           */
-	freenode(frame_ptr);
+	if (keep) {
+		frame_ptr->next_frame = func->frame_pool;
+		func->frame_pool = frame_ptr;
+		func->frame_pool_size++;
+	} else {
+		if (frame_ptr->stack != NULL)
+			efree(frame_ptr->stack);
+		freenode(frame_ptr);
+	}
 	if (do_profile || do_debug)
 		pop_frame();
 
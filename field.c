@@ -72,8 +72,24 @@ static void purge_record(void);
 
 static char *parse_extent;	/* marks where to restart parse of record */
 static long parse_high_water = 0; /* field number that we have parsed so far */
+static bool parse_mb;		/* text being split may have multibyte chars */
+static bool parse_ascii;	/* text being split by FPAT is all ASCII */
+static char *databuf;		/* the text of $0, unless $0 owns it */
+static size_t databuf_size;
+static NODE *split_owner;	/* string being split, if elements may share it */
+
+extern NODE *ARGV_node;
 static long nf_high_water = 0;	/* size of fields_arr */
 static bool resave_fs;
+/*
+ * The fields the program can use, when the parser could tell.  Others
+ * are counted but not kept.  NULL when any field may be used.
+ */
+static bool *wanted_fields = NULL;
+static long wanted_max = 0;
+
+#define field_wanted(num) \
+	(wanted_fields == NULL || ((num) <= wanted_max && wanted_fields[num]))
 static NODE *save_FS;		/* save current value of FS when line is read,
 				 * to be used in deferred parsing
 				 */
@@ -83,6 +99,18 @@ static NODE *save_FPAT;		/* save current value of FPAT when line is read,
 static awk_fieldwidth_info_t *FIELDWIDTHS = NULL;
 
 NODE **fields_arr;		/* array of pointers to the field nodes */
+/*
+ * Where the parsed fields are in $0.  The splitters only record the
+ * text of each field here; fields_arr[n] is filled in from it the first
+ * time $n is actually handed out.  Until then fields_arr[n] is an
+ * untouched copy of Null_field.  Entries above parse_high_water are
+ * never pending.
+ */
+static struct field_span {
+	char *str;
+	long len;
+	bool pending;		/* fields_arr[n] not yet set from str/len */
+} *field_spans;
 bool field0_valid;		/* $(>0) has not been changed yet */
 static int default_FS;		/* true when FS == " " */
 static Regexp *FS_re_yes_case = NULL;
@@ -91,6 +119,20 @@ static Regexp *FS_regexp = NULL;
 static Regexp *FPAT_re_yes_case = NULL;
 static Regexp *FPAT_re_no_case = NULL;
 static Regexp *FPAT_regexp = NULL;
+/*
+ * Common values of FPAT that are matched by hand instead of with the
+ * regexp matcher.  fpat_char is the separator character in them.
+ */
+static enum fpat_kind {
+	FPAT_REGEXP,		/* anything else */
+	FPAT_NOT_CHAR_PLUS,	/* [^,]+ */
+	FPAT_NOT_CHAR_STAR,	/* [^,]* */
+	FPAT_NOT_SPACE,		/* [^[:space:]]+, the default */
+	FPAT_CSV,		/* ([^,]*)|("[^"]+") */
+	FPAT_CSV_DQ,		/* ([^,]*)|("([^"]|"")+") */
+} fpat_kind = FPAT_REGEXP;
+static char fpat_char;
+static enum fpat_kind classify_fpat(const char *pat, size_t len, char *sep);
 NODE *Null_field = NULL;
 
 #define clear_mpfr(n) ((n)->flags &= ~(MPFN | MPZN | NUMCUR))
@@ -101,6 +143,7 @@ void
 init_fields()
 {
 	emalloc(fields_arr, NODE **, sizeof(NODE *));
+	ezalloc(field_spans, struct field_span *, sizeof(struct field_span));
 
 	fields_arr[0] = make_string("", 0);
 	fields_arr[0]->flags |= NULL_FIELD;
@@ -132,10 +175,12 @@ grow_fields_arr(long num)
 	NODE *n;
 
 	erealloc(fields_arr, NODE **, (num + 1) * sizeof(NODE *));
+	erealloc(field_spans, struct field_span *, (num + 1) * sizeof(struct field_span));
 	for (t = nf_high_water + 1; t <= num; t++) {
 		getnode(n);
 		*n = *Null_field;
 		fields_arr[t] = n;
+		field_spans[t].pending = false;
 	}
 	nf_high_water = num;
 }
@@ -149,14 +194,35 @@ set_field(long num,
 	long len,
 	NODE *dummy ATTRIBUTE_UNUSED)	/* just to make interface same as set_element */
 {
-	NODE *n;
+	struct field_span *fs;
 
 	if (num > nf_high_water)
 		grow_fields_arr(num);
-	n = fields_arr[num];
-	n->stptr = str;
-	n->stlen = len;
-	n->flags = (STRCUR|STRING|USER_INPUT);	/* do not set MALLOC */
+	if (! field_wanted(num))
+		return;
+	fs = & field_spans[num];
+	fs->str = str;
+	fs->len = len;
+	fs->pending = true;
+}
+
+/* materialize_field --- fill in the node for $num if it is still pending */
+
+static inline NODE **
+materialize_field(long num)
+{
+	struct field_span *fs = & field_spans[num];
+
+	if (fs->pending) {
+		NODE *n = fields_arr[num];
+
+		n->stptr = fs->str;
+		n->stlen = fs->len;
+		n->flags = (STRCUR|STRING|USER_INPUT);	/* do not set MALLOC */
+		n->flags |= (fields_arr[0]->flags & ASCIISTR);
+		fs->pending = false;
+	}
+	return & fields_arr[num];
 }
 
 /* set_comma_field --- set the value of a particular field, coming from CSV */
@@ -169,14 +235,19 @@ set_comma_field(long num,
 	NODE *dummy ATTRIBUTE_UNUSED)	/* just to make interface same as set_element */
 {
 	NODE *n;
-	NODE *val = make_string(str, len);
+	NODE *val;
 
 	if (num > nf_high_water)
 		grow_fields_arr(num);
+	if (! field_wanted(num))
+		return;
+	val = make_string(str, len);
 	n = fields_arr[num];
 	n->stptr = val->stptr;
 	n->stlen = val->stlen;
 	n->flags = (STRCUR|STRING|USER_INPUT|MALLOC);
+	n->flags |= (fields_arr[0]->flags & ASCIISTR);
+	field_spans[num].pending = false;
 	freenode(val);
 }
 
@@ -194,12 +265,17 @@ rebuild_record()
 	NODE *tmp;
 	char *ops;
 	char *cops;
+	char *run, *run_end, *run_dest;
 	long i;
 
 	assert(NF != -1);
 
 	tlen = 0;
 	for (i = NF; i > 0; i--) {
+		if (field_spans[i].pending) {
+			tlen += field_spans[i].len;
+			continue;
+		}
 		tmp = fields_arr[i];
 		tmp = force_string(tmp);
 		tlen += tmp->stlen;
@@ -210,18 +286,49 @@ rebuild_record()
 	emalloc(ops, char *, tlen + 1);
 	cops = ops;
 	ops[0] = '\0';
+
+	/*
+	 * Fields that have not been used are still only spans of the old $0.
+	 * Where several of them follow each other separated by exactly OFS,
+	 * the old text is already what we want, so copy it in one piece
+	 * and just move the spans.  After assigning one field of a record
+	 * whose separators are OFS, this is the unchanged text before the
+	 * field, the new value, and the unchanged text after it.
+	 */
+	run = run_end = run_dest = NULL;
 	for (i = 1;  i <= NF; i++) {
-		free_wstr(fields_arr[i]);
-		tmp = fields_arr[i];
-		/* copy field */
-		if (tmp->stlen == 1)
-			*cops++ = tmp->stptr[0];
-		else if (tmp->stlen != 0) {
-			memcpy(cops, tmp->stptr, tmp->stlen);
-			cops += tmp->stlen;
+		struct field_span *fs = & field_spans[i];
+
+		if (fs->pending) {
+			char *str = fs->str;
+
+			if (run != NULL && str == run_end + OFSlen
+			    && memcmp(run_end, OFS, OFSlen) == 0) {
+				/* extend the run, OFS and all */
+			} else {
+				if (run != NULL) {
+					memcpy(cops, run, run_end - run);
+					cops += run_end - run;
+				}
+				if (i != 1) {
+					memcpy(cops, OFS, OFSlen);
+					cops += OFSlen;
+				}
+				run = str;
+				run_dest = cops;
+			}
+			run_end = str + fs->len;
+			fs->str = run_dest + (str - run);
+			continue;
+		}
+
+		if (run != NULL) {
+			memcpy(cops, run, run_end - run);
+			cops += run_end - run;
+			run = NULL;
 		}
 		/* copy OFS */
-		if (i != NF) {
+		if (i != 1) {
 			if (OFSlen == 1)
 				*cops++ = *OFS;
 			else if (OFSlen != 0) {
@@ -229,49 +336,59 @@ rebuild_record()
 				cops += OFSlen;
 			}
 		}
-	}
-	tmp = make_str_node(ops, tlen, ALREADY_MALLOCED);
 
-	/*
-	 * Since we are about to unref fields_arr[0], we want to find
-	 * any fields that still point into it, and have them point
-	 * into the new field zero.  This has to be done intelligently,
-	 * so that unrefing a field doesn't try to unref into the old $0.
-	 */
-	for (cops = ops, i = 1; i <= NF; i++) {
-		NODE *r = fields_arr[i];
+		free_wstr(fields_arr[i]);
+		tmp = fields_arr[i];
+		/* copy field */
+		if (tmp->stlen == 1)
+			*cops = tmp->stptr[0];
+		else if (tmp->stlen != 0)
+			memcpy(cops, tmp->stptr, tmp->stlen);
+
 		/*
+		 * Since we are about to unref fields_arr[0], we want to find
+		 * any fields that still point into it, and have them point
+		 * into the new field zero.  This has to be done intelligently,
+		 * so that unrefing a field doesn't try to unref into the old $0.
+		 *
 		 * There is no reason to copy malloc'ed fields to point into
 		 * the new $0 buffer, although that's how previous versions did
 		 * it. It seems faster to leave the malloc'ed fields in place.
 		 */
-		if (r->stlen > 0 && (r->flags & MALLOC) == 0) {
+		if (tmp->stlen > 0 && (tmp->flags & MALLOC) == 0) {
 			NODE *n;
 			getnode(n);
 
-			*n = *r;
-			if (r->valref > 1) {
+			*n = *tmp;
+			if (tmp->valref > 1) {
 				/*
 				 * This can and does happen.  It seems clear that
-				 * we can't leave r's stptr pointing into the
+				 * we can't leave tmp's stptr pointing into the
 				 * old $0 buffer that we are about to unref.
 				 */
-				emalloc(r->stptr, char *, r->stlen + 1);
-				memcpy(r->stptr, cops, r->stlen);
-				r->stptr[r->stlen] = '\0';
-				r->flags |= MALLOC;
+				emalloc(tmp->stptr, char *, tmp->stlen + 1);
+				memcpy(tmp->stptr, cops, tmp->stlen);
+				tmp->stptr[tmp->stlen] = '\0';
+				tmp->flags |= MALLOC;
 
 				n->valref = 1;	// reset in the new field to start it off correctly!
 			}
 
 			n->stptr = cops;
 			clear_mpfr(n);
-			unref(r);
+			unref(tmp);
 			fields_arr[i] = n;
 			assert((n->flags & WSTRCUR) == 0);
 		}
-		cops += fields_arr[i]->stlen + OFSlen;
+		cops += fields_arr[i]->stlen;
+	}
+	if (run != NULL) {
+		memcpy(cops, run, run_end - run);
+		cops += run_end - run;
 	}
+	assert(cops == ops + tlen);
+	*cops = '\0';
+	tmp = make_str_node(ops, tlen, ALREADY_MALLOCED);
 
 	assert((fields_arr[0]->flags & MALLOC) == 0
 		? fields_arr[0]->valref == 1
@@ -297,8 +414,6 @@ void
 set_record(const char *buf, size_t cnt, const awk_fieldwidth_info_t *fw)
 {
 	NODE *n;
-	static char *databuf;
-	static size_t databuf_size;
 #define INITIAL_SIZE	512
 #define MAX_SIZE	((size_t) ~0)	/* maximally portable ... */
 
@@ -370,6 +485,51 @@ set_record(const char *buf, size_t cnt, const awk_fieldwidth_info_t *fw)
 #undef MAX_SIZE
 }
 
+/*
+ * record_owner --- return $0 if the len bytes at s are part of its text.
+ *
+ * That text is normally in databuf, which the next record overwrites.
+ * For a string to share it, $0 takes databuf for its own and set_record()
+ * starts a new one.
+ */
+
+NODE *
+record_owner(const char *s, size_t len)
+{
+	NODE *r = fields_arr[0];
+
+	if (s < r->stptr || s + len > r->stptr + r->stlen)
+		return NULL;
+
+	if ((r->flags & MALLOC) == 0) {
+		assert(r->stptr == databuf);
+		r->flags |= MALLOC;
+		emalloc(databuf, char *, databuf_size);
+	}
+
+	return r;
+}
+
+/*
+ * elements_owner --- return src if the elements that split() puts
+ * into arr may share its text.
+ *
+ * gawk reads the elements of ARGV, ENVIRON and PROCINFO as C strings,
+ * so those get copies.
+ */
+
+static NODE *
+elements_owner(NODE *src, NODE *arr)
+{
+	if (   (src->flags & MALLOC) == 0
+	    || arr->astore != NULL
+	    || arr == ARGV_node
+	    || arr == PROCINFO_node)
+		return NULL;
+
+	return src;
+}
+
 /* reset_record --- start over again with current $0 */
 
 void
@@ -398,6 +558,12 @@ purge_record()
 	for (i = 1; i <= parse_high_water; i++) {
 		NODE *n;
 		NODE *r = fields_arr[i];
+
+		if (field_spans[i].pending) {
+			/* never handed out, still a copy of Null_field */
+			field_spans[i].pending = false;
+			continue;
+		}
 		if ((r->flags & MALLOC) == 0 && r->valref > 1) {
 			/* This can and does happen. We must copy the string! */
 			const char *save = r->stptr;
@@ -441,6 +607,21 @@ set_NF()
 	if (nf < 0)
 		fatal(_("NF set to negative value"));
 
+	/*
+	 * The parser only keeps some of the fields when nothing in the
+	 * program sets NF.  This is an assignment from the command line,
+	 * and $0 is about to be rebuilt from all the fields, so keep them
+	 * all from now on and split the record again.
+	 */
+	if (wanted_fields != NULL) {
+		efree(wanted_fields);
+		wanted_fields = NULL;
+		if (field0_valid) {
+			purge_record();
+			(void) get_field(UNLIMITED - 1, NULL);
+		}
+	}
+
 	static bool warned = false;
 	if (do_lint && NF > nf && ! warned) {
 		warned = true;
@@ -461,6 +642,10 @@ set_NF()
 		parse_high_water = NF;
 	} else if (parse_high_water > 0) {
 		for (i = NF + 1; i >= 0 && i <= parse_high_water; i++) {
+			if (field_spans[i].pending) {
+				field_spans[i].pending = false;
+				continue;
+			}
 			unref(fields_arr[i]);
 			getnode(n);
 			*n = *Null_field;
@@ -527,7 +712,7 @@ re_parse_field(long up_to,	/* parse only up to this field number */
 	       && nf < up_to) {
 		regex_flags |= RE_NO_BOL;
 		if (REEND(rp, scan) == RESTART(rp, scan)) {   /* null match */
-			if (gawk_mb_cur_max > 1)	{
+			if (parse_mb)	{
 				mbclen = mbrlen(scan, end-scan, &mbs);
 				if ((mbclen == 1) || (mbclen == (size_t) -1)
 					|| (mbclen == (size_t) -2) || (mbclen == 0)) {
@@ -562,6 +747,64 @@ re_parse_field(long up_to,	/* parse only up to this field number */
 	return nf;
 }
 
+#ifdef USE_SSE2
+
+/* blank_mask --- bit i is set if p[i] is a space, tab or newline */
+
+static inline unsigned int
+blank_mask(const char *p)
+{
+	__m128i block = _mm_loadu_si128((const __m128i *) p);
+	__m128i blanks = _mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+			     _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+		_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+
+	return (unsigned int) _mm_movemask_epi8(blanks);
+}
+#endif
+
+/*
+ * skip_blanks --- return the first character at or after scan, but
+ *	before end, that is not a space, tab or newline; or end.  With SSE2,
+ *	sixteen characters at a time are checked.
+ */
+
+static inline char *
+skip_blanks(char *scan, char *end)
+{
+#ifdef USE_SSE2
+	unsigned int mask;
+
+	for (; end - scan >= 16; scan += 16)
+		if ((mask = ~blank_mask(scan) & 0xFFFF) != 0)
+			return scan + __builtin_ctz(mask);
+#endif
+	while (scan < end && (*scan == ' ' || *scan == '\t' || *scan == '\n'))
+		scan++;
+	return scan;
+}
+
+/*
+ * find_blank --- return the first space, tab or newline at or after scan.
+ *	The caller has put a sentinel blank at end.
+ */
+
+static inline char *
+find_blank(char *scan, char *end)
+{
+#ifdef USE_SSE2
+	unsigned int mask;
+
+	for (; end - scan >= 16; scan += 16)
+		if ((mask = blank_mask(scan)) != 0)
+			return scan + __builtin_ctz(mask);
+#endif
+	while (*scan != ' ' && *scan != '\t' && *scan != '\n')
+		scan++;
+	return scan;
+}
+
 /*
  * def_parse_field --- default field parsing.
  *
@@ -613,8 +856,7 @@ def_parse_field(long up_to,	/* parse only up to this field number */
 		/*
 		 * special case:  fs is single space, strip leading whitespace
 		 */
-		while (scan < end && (*scan == ' ' || *scan == '\t' || *scan == '\n'))
-			scan++;
+		scan = skip_blanks(scan, end);
 
 		if (sep_arr != NULL && scan > sep)
 			set_element(nf, sep, (long) (scan - sep), sep_arr);
@@ -624,8 +866,7 @@ def_parse_field(long up_to,	/* parse only up to this field number */
 
 		field = scan;
 
-		while (*scan != ' ' && *scan != '\t' && *scan != '\n')
-			scan++;
+		scan = find_blank(scan, end);
 
 		(*set)(++nf, field, (long)(scan - field), n);
 
@@ -668,7 +909,7 @@ null_parse_field(long up_to,	/* parse only up to this field number */
 	if (len == 0)
 		return nf;
 
-	if (gawk_mb_cur_max > 1) {
+	if (parse_mb) {
 		mbstate_t mbs;
 		memset(&mbs, 0, sizeof(mbstate_t));
 		for (; nf < up_to && scan < end;) {
@@ -741,7 +982,7 @@ sc_parse_field(long up_to,	/* parse only up to this field number */
 
 	for (; nf < up_to;) {
 		field = scan;
-		if (gawk_mb_cur_max > 1) {
+		if (parse_mb) {
 			while (*scan != fschar) {
 				mbclen = mbrlen(scan, end-scan, &mbs);
 				if ((mbclen == 1) || (mbclen == (size_t) -1)
@@ -774,12 +1015,44 @@ sc_parse_field(long up_to,	/* parse only up to this field number */
 	return nf;
 }
 
+static char *csv_field = NULL;	/* the current CSV field, without quotes */
+static size_t csv_field_size = 0;
+
+/*
+ * csv_copy --- append len characters at str to the CSV field being built
+ *	at *new_end, growing it as needed.  Nothing is copied when the
+ *	field is not being kept.
+ */
+
+static inline void
+csv_copy(char **new_end, const char *str, size_t len, bool keep)
+{
+	size_t used;
+
+	if (! keep || len == 0)
+		return;
+
+	used = *new_end - csv_field;
+	if (used + len > csv_field_size) {
+		do {
+			csv_field_size *= 2;
+		} while (used + len > csv_field_size);
+		erealloc(csv_field, char *, csv_field_size);
+		*new_end = csv_field + used;
+	}
+	memcpy(*new_end, str, len);
+	*new_end += len;
+}
+
 /*
  * comma_parse_field --- CSV parsing same as BWK awk.
  *
  * This is called both from get_field() and from do_split()
  * via (*parse_field)().  This variation is for when FS is a comma,
  * we do very basic CSV parsing, the same as BWK awk.
+ *
+ * The text between quotes and commas is found with memchr() and
+ * copied in one piece.
  */
 
 static long
@@ -797,13 +1070,12 @@ comma_parse_field(long up_to,	/* parse only up to this field number */
 	static const char comma = ',';
 	long nf = parse_high_water;
 	char *end = scan + len;
+	char *stop;
+	bool keep;
 
-	static char *newfield = NULL;
-	static size_t buflen = 0;
-
-	if (newfield == NULL) {
-		emalloc(newfield, char *, BUFSIZ);
-		buflen = BUFSIZ;
+	if (csv_field == NULL) {
+		emalloc(csv_field, char *, BUFSIZ);
+		csv_field_size = BUFSIZ;
 	}
 
 	if (set == set_field)	// not an array element
@@ -820,49 +1092,43 @@ comma_parse_field(long up_to,	/* parse only up to this field number */
 	}
 
 	for (; nf < up_to;) {
-		char *new_end = newfield;
-		memset(newfield, '\0', buflen);
+		char *new_end = csv_field;
 
+		keep = (set != set_comma_field || field_wanted(nf + 1));
 		while (*scan != comma && scan < end) {
 			if (*scan == '"') {
 				for (scan++; scan < end;) {
-					// grow buffer if needed
-					if (new_end >= newfield + buflen) {
-						size_t offset = buflen;
-
-						buflen *= 2;
-						erealloc(newfield, char *, buflen);
-						new_end = newfield + offset;
-					}
+					stop = memchr(scan, '"', end - scan);
+					if (stop == NULL)
+						stop = end;
+					csv_copy(& new_end, scan, stop - scan, keep);
+					scan = stop;
+					if (scan == end)
+						break;
 
-					if (*scan == '"' && scan[1] == '"') {	// "" -> "
-						*new_end++ = '"';
+					if (scan[1] == '"') {	// "" -> "
+						csv_copy(& new_end, scan, 1, keep);
 						scan += 2;
-					} else if (*scan == '"' && (scan == end-1 || scan[1] == comma)) {
+					} else if (scan == end-1 || scan[1] == comma) {
 						// close of quoted string
 						scan++;
 						break;
 					} else {
-						*new_end++ = *scan++;
+						csv_copy(& new_end, scan, 1, keep);
+						scan++;
 					}
 				}
 			} else {
 				// unquoted field
-				while (*scan != comma && scan < end) {
-					// grow buffer if needed
-					if (new_end >= newfield + buflen) {
-						size_t offset = buflen;
-
-						buflen *= 2;
-						erealloc(newfield, char *, buflen);
-						new_end = newfield + offset;
-					}
-					*new_end++ = *scan++;
-				}
+				stop = memchr(scan, comma, end - scan);
+				if (stop == NULL)
+					stop = end;
+				csv_copy(& new_end, scan, stop - scan, keep);
+				scan = stop;
 			}
 		}
 
-		(*set)(++nf, newfield, (long)(new_end - newfield), n);
+		(*set)(++nf, csv_field, (long)(new_end - csv_field), n);
 
 		if (scan == end)
 			break;
@@ -874,7 +1140,7 @@ comma_parse_field(long up_to,	/* parse only up to this field number */
 
 		scan++;
 		if (scan == end) {	/* FS at end of record */
-			(*set)(++nf, newfield, 0L, n);
+			(*set)(++nf, csv_field, 0L, n);
 			break;
 		}
 	}
@@ -939,7 +1205,7 @@ fw_parse_field(long up_to,	/* parse only up to this field number */
 		nf = 0;
 	if (len == 0)
 		return nf;
-	if (gawk_mb_cur_max > 1 && fw->use_chars) {
+	if (parse_mb && fw->use_chars) {
 		/*
 		 * Reset the shift state. Arguably, the shift state should
 		 * be part of the file state and carried forward at all times,
@@ -1020,6 +1286,9 @@ get_field(long requested, Func_ptr *assign)
 					saved_fs = save_FS;
 					fs_regexp = FS_regexp;
 				}
+				parse_mb = mb_string(fields_arr[0]);
+				parse_ascii = (parse_field == fpat_parse_field
+						&& str_is_ascii(fields_arr[0]));
 				NF = (*parse_field)(UNLIMITED - 1, &parse_extent,
 		    			fields_arr[0]->stlen -
 					(parse_extent - fields_arr[0]->stptr),
@@ -1060,7 +1329,7 @@ get_field(long requested, Func_ptr *assign)
 	}
 
 	if (requested <= parse_high_water)	/* already parsed this field */
-		return &fields_arr[requested];
+		return materialize_field(requested);
 
 	if (NF == -1) {	/* have not yet parsed to end of record */
 		/*
@@ -1071,6 +1340,9 @@ get_field(long requested, Func_ptr *assign)
 			parse_extent = fields_arr[0]->stptr;
 		else
 			in_middle = true;
+		parse_mb = mb_string(fields_arr[0]);
+		parse_ascii = (parse_field == fpat_parse_field
+				&& str_is_ascii(fields_arr[0]));
 		parse_high_water = (*parse_field)(requested, &parse_extent,
 		     fields_arr[0]->stlen - (parse_extent - fields_arr[0]->stptr),
 		     save_FS, NULL, set_field, (NODE *) NULL, (NODE *) NULL, in_middle);
@@ -1099,7 +1371,44 @@ get_field(long requested, Func_ptr *assign)
 			return &Null_field;
 	}
 
-	return &fields_arr[requested];
+	return materialize_field(requested);
+}
+
+/*
+ * set_field_projection --- called by the parser with the fields the
+ *	program uses, when it uses no others.  Takes over wanted.
+ */
+
+void
+set_field_projection(bool *wanted, long max)
+{
+	if (wanted_fields != NULL)
+		efree(wanted_fields);
+	wanted_fields = wanted;
+	wanted_max = max;
+}
+
+/* print_field_projection --- show the fields kept, for --dump-variables */
+
+void
+print_field_projection(FILE *fp)
+{
+	long i;
+	const char *sep = " ";
+
+	if (wanted_fields == NULL)
+		return;
+
+	fprintf(fp, "# fields used:");
+	for (i = 1; i <= wanted_max; i++) {
+		if (wanted_fields[i]) {
+			fprintf(fp, "%s$%ld", sep, i);
+			sep = ", ";
+		}
+	}
+	if (wanted_max == 0)
+		fprintf(fp, " none");
+	fprintf(fp, "\n");
 }
 
 /* set_element --- set an array element, used by do_split() */
@@ -1110,7 +1419,10 @@ set_element(long num, char *s, long len, NODE *n)
 	NODE *it;
 	NODE *sub;
 
-	it = make_string(s, len);
+	if (split_owner != NULL)
+		it = make_str_view(split_owner, s, len);
+	else
+		it = make_string(s, len);
 	it->flags |= USER_INPUT;
 	sub = make_number(num);
 	assoc_set(n, sub, it);
@@ -1249,9 +1561,12 @@ do_split(int nargs)
 	 * The check for do_csv prevents dereferencing fs which is NULL if do_csv.
 	 */
 	s = src->stptr;
+	parse_mb = mb_string(src);
+	split_owner = elements_owner(src, arr);
 	tmp = make_number((double) (*parseit)(UNLIMITED, &s, (int) src->stlen,
 					     fs, rp, set_element, arr, sep_arr,
 					     ! do_csv && fs->stlen == 1));
+	split_owner = NULL;
 
 	src = POP_SCALAR();	/* really pop off stack */
 	DEREF(src);
@@ -1338,9 +1653,13 @@ do_patsplit(int nargs)
 	} else {
 		rp = re_update(sep);
 		s = src->stptr;
+		parse_mb = mb_string(src);
+		parse_ascii = str_is_ascii(src);
+		split_owner = elements_owner(src, arr);
 		tmp = make_number((double) fpat_parse_field(UNLIMITED, &s,
 				(int) src->stlen, fpat, rp,
 				set_element, arr, sep_arr, false));
+		split_owner = NULL;
 	}
 
 	DEREF(src);
@@ -1734,7 +2053,55 @@ set_fpat_function:
 		FPAT_re_yes_case = make_regexp(fpat->stptr, fpat->stlen, false, true, true);
 		FPAT_re_no_case = make_regexp(fpat->stptr, fpat->stlen, true, true, true);
 		FPAT_regexp = (IGNORECASE ? FPAT_re_no_case : FPAT_re_yes_case);
+		fpat_kind = classify_fpat(fpat->stptr, fpat->stlen, & fpat_char);
+	}
+}
+
+/*
+ * classify_fpat --- see if FPAT is one of the patterns fpat_match()
+ *	knows.  The separator character may be any punctuation character
+ *	other than those special in a bracket expression.
+ */
+
+static enum fpat_kind
+classify_fpat(const char *pat, size_t len, char *sep)
+{
+	static const struct {
+		const char *pat;
+		enum fpat_kind kind;
+	} known[] = {
+		{ "[^@]+",			FPAT_NOT_CHAR_PLUS },
+		{ "[^@]*",			FPAT_NOT_CHAR_STAR },
+		{ "[^[:space:]]+",		FPAT_NOT_SPACE },
+		{ "([^@]*)|(\"[^\"]+\")",		FPAT_CSV },
+		{ "([^@]*)|(\"([^\"]|\"\")+\")",	FPAT_CSV_DQ },
+	};
+	const char *p, *k;
+	size_t i;
+	char c;
+
+	if (do_posix || do_traditional)
+		return FPAT_REGEXP;
+
+	for (i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+		c = '\0';
+		for (p = pat, k = known[i].pat; p < pat + len && *k != '\0'; p++, k++) {
+			if (*k != '@') {
+				if (*p != *k)
+					break;
+			} else if (c == '\0' && (unsigned char) *p < 128
+					&& (ispunct((unsigned char) *p) || *p == '\t')
+					&& strchr("\\]^-[\"", *p) == NULL) {
+				c = *p;
+			} else if (*p != c)
+				break;
+		}
+		if (p == pat + len && *k == '\0') {
+			*sep = c;
+			return known[i].kind;
+		}
 	}
+	return FPAT_REGEXP;
 }
 
 /*
@@ -1751,7 +2118,7 @@ incr_scan(char **scanp, size_t len, mbstate_t *mbs)
 {
 	size_t mbclen = 0;
 
-	if (gawk_mb_cur_max > 1) {
+	if (parse_mb) {
 		mbclen = mbrlen(*scanp, len, mbs);
 		if (   (mbclen == 1)
 		    || (mbclen == (size_t) -1)
@@ -1765,6 +2132,112 @@ incr_scan(char **scanp, size_t len, mbstate_t *mbs)
 		(*scanp)++;
 }
 
+/* is_fpat_space --- the characters [[:space:]] matches in ASCII */
+
+static inline bool
+is_fpat_space(int c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/*
+ * fpat_match --- find the leftmost-longest match for one of the patterns
+ *	that classify_fpat() recognizes, the same one the regexp matcher
+ *	would find.  Only used on ASCII text.
+ */
+
+static bool
+fpat_match(char *scan, char *end, char **mstart, char **mend)
+{
+	char *p, *q, *last;
+
+	switch (fpat_kind) {
+	case FPAT_NOT_CHAR_PLUS:
+		for (p = scan; p < end && *p == fpat_char; p++)
+			continue;
+		if (p == end)
+			return false;
+		if ((q = memchr(p, fpat_char, end - p)) == NULL)
+			q = end;
+		break;
+
+	case FPAT_NOT_SPACE:
+		for (p = scan; p < end && is_fpat_space(*p); p++)
+			continue;
+		if (p == end)
+			return false;
+		for (q = p; q < end && ! is_fpat_space(*q); q++)
+			continue;
+		break;
+
+	case FPAT_NOT_CHAR_STAR:
+	case FPAT_CSV:
+	case FPAT_CSV_DQ:
+		/* [^,]* always matches, maybe the null string, at scan */
+		p = scan;
+		if ((q = memchr(p, fpat_char, end - p)) == NULL)
+			q = end;
+		if (fpat_kind == FPAT_NOT_CHAR_STAR || p == end || *p != '"')
+			break;
+
+		/* the quoted alternative wins if it is longer */
+		if (fpat_kind == FPAT_CSV) {
+			last = memchr(p + 1, '"', end - (p + 1));
+			if (last != NULL && last > p + 1 && last + 1 > q)
+				q = last + 1;
+			break;
+		}
+
+		/*
+		 * "([^"]|"")+": at each quote the match may end, or go on
+		 * if the quote is doubled.  The longest match ends at the
+		 * last quote where it may end.
+		 */
+		last = NULL;
+		for (p = scan + 1; p < end; p++) {
+			if (*p != '"')
+				continue;
+			if (p > scan + 1)
+				last = p + 1;	/* could close here */
+			if (p + 1 < end && p[1] == '"')
+				p++;		/* or take "" and go on */
+			else
+				break;
+		}
+		p = scan;
+		if (last != NULL && last > q)
+			q = last;
+		break;
+
+	default:
+		cant_happen("unexpected fpat_kind %d", (int) fpat_kind);
+		return false;
+	}
+
+	*mstart = p;
+	*mend = q;
+	return true;
+}
+
+/*
+ * fpat_search --- find the next field for fpat_parse_field(), by hand if
+ *	possible, otherwise with research().
+ */
+
+static inline bool
+fpat_search(Regexp *rp, char *scan, char *end, int regex_flags, bool by_hand,
+	char **mstart, char **mend)
+{
+	if (by_hand)
+		return fpat_match(scan, end, mstart, mend);
+
+	if (research(rp, scan, 0, (end - scan), regex_flags) == -1)
+		return false;
+	*mstart = scan + RESTART(rp, scan);
+	*mend = scan + REEND(rp, scan);
+	return true;
+}
+
 /*
  * fpat_parse_field --- parse fields using a regexp.
  *
@@ -1850,8 +2323,9 @@ fpat_parse_field(long up_to,	/* parse only up to this field number */
 	char *end = scan + len;
 	int regex_flags = RE_NEED_START;
 	mbstate_t mbs;
-	char* field_start;
+	char *field_start, *field_end;
 	bool field_found = false;
+	bool by_hand;
 
 	memset(&mbs, 0, sizeof(mbstate_t));
 
@@ -1864,21 +2338,25 @@ fpat_parse_field(long up_to,	/* parse only up to this field number */
 	if (rp == NULL) /* use FPAT */
 		rp = FPAT_regexp;
 
+	/* by hand only for ASCII, where the locale does not matter */
+	by_hand = (rp == FPAT_regexp && fpat_kind != FPAT_REGEXP && parse_ascii);
+
 	while (scan < end && nf < up_to) {  /* still something to parse */
 
 		/* first attempt to match the next field */
 		start = scan;
-		field_found = research(rp, scan, 0, (end - scan), regex_flags) != -1;
+		field_found = fpat_search(rp, scan, end, regex_flags, by_hand,
+					& field_start, & field_end);
 
 		/* check for an invalid null field and retry one character away */
-		if (nf > 0 && field_found && REEND(rp, scan) == 0) { /* invalid null field */
+		if (nf > 0 && field_found && field_end == scan) { /* invalid null field */
 			increment_scan(& scan, end - scan);
-			field_found = research(rp, scan, 0, (end - scan), regex_flags) != -1;
+			field_found = fpat_search(rp, scan, end, regex_flags, by_hand,
+						& field_start, & field_end);
 		}
 
 		/* store the (sep[n-1],field[n]) pair */
 		if (field_found) {
-			field_start = scan + RESTART(rp, scan);
 			if (sep_arr != NULL) { /* store the separator */
 				if (field_start == start) /* match at front */
 					set_element(nf, start, 0L, sep_arr);
@@ -1891,9 +2369,9 @@ fpat_parse_field(long up_to,	/* parse only up to this field number */
 			/* field is text that matched */
 			(*set)(++nf,
 				field_start,
-				(long)(REEND(rp, scan) - RESTART(rp, scan)),
+				(long)(field_end - field_start),
 				n);
-			scan += REEND(rp, scan);
+			scan = field_end;
 
 		} else {
 			/*
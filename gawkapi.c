@@ -470,11 +470,12 @@ assign_string(NODE *node, awk_value_t *val, awk_valtype_t val_type)
 	if (node->stptr[node->stlen] != '\0') {
 		/*
 		 * This is an unterminated field string, so make a copy.
-		 * This should happen only for $n where n > 0 and n < NF.
+		 * This should happen only for $n where n > 0 and n < NF,
+		 * and for views made by substr() and split().
 		 */
 		char *s;
 
-		assert((node->flags & MALLOC) == 0);
+		assert((node->flags & (MALLOC|STRVIEW)) != MALLOC);
 		if (scopy.i == scopy.size) {
 			/* expand list */
 			if (scopy.size == 0)
@@ -954,7 +955,7 @@ api_sym_update_scalar(awk_ext_id_t id,
 
 			/* r_unref: */
 			if ((r->flags & (MALLOC|STRCUR)) == (MALLOC|STRCUR))
-				efree(r->stptr);
+				free_stptr(r);
 			free_wstr(r);
 
 			/* r_make_number: */
@@ -973,7 +974,7 @@ api_sym_update_scalar(awk_ext_id_t id,
 
 			/* r_unref: */
 			if ((r->flags & (MALLOC|STRCUR)) == (MALLOC|STRCUR))
-				efree(r->stptr);
+				free_stptr(r);
 
 			mpfr_unset(r);
 			free_wstr(r);
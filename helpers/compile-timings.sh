@@ -0,0 +1,39 @@
+#! /bin/bash
+
+# Time parsing and optimizing a large generated program that does nothing
+# when run, with the optimizer (the default) and without it (-s).  Run from
+# the top of a build directory, optionally giving another gawk to compare
+# against, such as one built from an earlier version:
+#
+#	helpers/compile-timings.sh [other-gawk]
+
+GAWK=${GAWK:-./gawk}
+OTHER=$1
+NFUNCS=${NFUNCS:-32000}
+
+file=COMPILE.awk
+$GAWK -v nfuncs=$NFUNCS 'BEGIN {
+	print "function twice(x) { return x * 2 }"
+	for (i = 0; i < nfuncs; i++) {
+		printf "function f%d(a, b,   c, d) {\n", i
+		printf "\tc = a + b * %d\n", i
+		printf "\tif (c > 10) d = substr(\"x%d\", 1, 2) length(a)\n", i
+		printf "\tfor (d = 0; d < b; d++) c += twice(d)\n"
+		printf "\tcount++\n"
+		printf "\treturn c (d ? f%d(a, b - 1) : \"\")\n", (i + 1) % nfuncs
+		printf "}\n"
+	}
+	print "BEGIN { exit }"
+	print "{ total += $2 }"
+}' > $file
+
+for awk in $GAWK $OTHER
+do
+	for opt in "" -s
+	do
+		echo "$NFUNCS functions, $awk${opt:+ $opt}:"
+		time $awk $opt -f $file
+	done
+done
+
+rm -f $file
@@ -0,0 +1,41 @@
+#! /bin/bash
+
+# Time default (FS = " ") field splitting on records with 5, 20 and
+# 200 columns.  Run from the top of a build directory, optionally
+# giving another gawk to compare against:
+#
+#	helpers/field-timings.sh [other-gawk]
+
+GAWK=${GAWK:-./gawk}
+OTHER=$1
+NLINES=${NLINES:-200000}
+
+for cols in 5 20 200
+do
+	file=FIELDS.$cols
+	if ! [ -f $file ]
+	then
+		echo creating $file
+		$GAWK -v cols=$cols -v lines=$NLINES 'BEGIN {
+			srand(1)
+			for (i = 1; i <= lines; i++) {
+				line = ""
+				for (j = 1; j <= cols; j++)
+					line = line sprintf("%s%.*s", (j > 1 ? (j % 7 ? " " : " \t ") : ""), 1 + int(rand() * 12), "abcdefghijklmnop")
+				print line
+			}
+		}' > $file
+	fi
+	cat $file > /dev/null	# fill the buffer cache
+
+	for prog in '{ n += NF } END { print n }' '{ x = $7 }' '{ x = $NF }'
+	do
+		for awk in $GAWK $OTHER
+		do
+			echo "$cols columns, $awk '$prog':"
+			time $awk "$prog" $file > /dev/null
+		done
+	done
+done
+
+rm -f FIELDS.*
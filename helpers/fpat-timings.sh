@@ -0,0 +1,45 @@
+#! /bin/bash
+
+# Time field splitting with FPAT against the equivalent FS, for the
+# FPAT values that are matched by hand and for one that is not.  Run
+# from the top of a build directory, optionally giving another gawk to
+# compare against:
+#
+#	helpers/fpat-timings.sh [other-gawk]
+
+GAWK=${GAWK:-./gawk}
+OTHER=$1
+NLINES=${NLINES:-200000}
+
+file=FPAT.csv
+echo creating $file
+$GAWK -v lines=$NLINES 'BEGIN {
+	srand(1)
+	for (i = 1; i <= lines; i++) {
+		line = ""
+		for (j = 1; j <= 20; j++) {
+			if (j % 5 == 0)
+				field = sprintf("\"%d, \"\"%d\"\"\"", rand() * 1000, rand() * 1000)
+			else
+				field = sprintf("%d", rand() * 100000)
+			line = line (j > 1 ? "," : "") field
+		}
+		print line
+	}
+}' > $file
+cat $file > /dev/null	# fill the buffer cache
+
+prog='{ n += NF; x = $3 } END { print n }'
+
+for setting in 'FS=,' 'FPAT=[^,]+' 'FPAT=[^,]*' 'FPAT=[^[:space:]]+' \
+	'FPAT=([^,]*)|("[^"]+")' 'FPAT=([^,]*)|("([^"]|"")+")' \
+	'FPAT=([^,]*)|("[^"]*")'
+do
+	for awk in $GAWK $OTHER
+	do
+		echo "$awk -v '$setting':"
+		time $awk -v "$setting" "$prog" $file > /dev/null
+	done
+done
+
+rm -f $file
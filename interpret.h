@@ -40,6 +40,8 @@ static inline void
 unfield(NODE **l, NODE **r)
 {
 	/* if was a field, turn it into a var */
+	if (((*r)->flags & STRVIEW) != 0)
+		unshare_string(*r);
 	if (((*r)->flags & MALLOC) != 0 || (*r)->valref == 1) {
 		(*l) = (*r);
 	} else {
@@ -282,6 +284,12 @@ uninitialized_scalar:
 			PUSH(pc->memory);
 			break;
 
+		case Op_push_stack:
+			m = PEEK(pc->stack_offset);
+			UPREF(m);
+			PUSH(m);
+			break;
+
 		case Op_push_lhs:
 			lhs = get_lhs(pc->memory, pc->do_reference);
 			PUSH_ADDRESS(lhs);
@@ -596,6 +604,57 @@ uninitialized_scalar:
 			REPLACE(r);
 			break;
 
+		case Op_cmp_num:
+		case Op_jmp_cmp_true:
+		case Op_jmp_cmp_false:
+			/*
+			 * The parser expects both values to be numbers, see
+			 * awkgram.y (opt_numeric_types); if they are not,
+			 * compare them the usual way.
+			 */
+			t2 = TOP();
+			t1 = PEEK(1);
+			if (t1->type == Node_val && (t1->flags & (NUMBER|STRING|REGEX)) == NUMBER
+			    && t2->type == Node_val && (t2->flags & (NUMBER|STRING|REGEX)) == NUMBER) {
+				switch (pc->cmp_type) {
+				case SCALAR_EQ:
+					di = (t1->numbr == t2->numbr);
+					break;
+				case SCALAR_NEQ:
+					di = (t1->numbr != t2->numbr);
+					break;
+				case SCALAR_LT:
+					di = (t1->numbr < t2->numbr);
+					break;
+				case SCALAR_LE:
+					di = (t1->numbr <= t2->numbr);
+					break;
+				case SCALAR_GT:
+					di = (t1->numbr > t2->numbr);
+					break;
+				case SCALAR_GE:
+					di = (t1->numbr >= t2->numbr);
+					break;
+				default:
+					cant_happen("invalid value %d in Op_cmp_num", (int) pc->cmp_type);
+					di = 0;
+					break;
+				}
+				decr_sp();
+				DEREF(t2);
+				DEREF(t1);
+			} else
+				di = cmp_scalars((scalar_cmp_t) pc->cmp_type);
+			decr_sp();
+
+			if (op == Op_cmp_num) {
+				r = node_Boolean[di];
+				UPREF(r);
+				PUSH(r);
+			} else if (di == (op == Op_jmp_cmp_true))
+				JUMPTO(pc->target_jmp);
+			break;
+
 		case Op_plus_i:
 			t2 = pc->memory;
 			x2 = force_number(pc->memory)->numbr;
@@ -842,6 +901,7 @@ mod:
 			UNFIELD(*lhs, r);
 			/* field variables need the string representation: */
 			force_string(*lhs);
+			settle_string(*lhs);
 			if (op == Op_store_field_exp) {
 				UPREF(*lhs);
 				PUSH(*lhs);
@@ -863,17 +923,28 @@ mod:
 					*lhs = dupnode(t1);
 			}
 
-			if (t1 != t2 && t1->valref == 1 && (t1->flags & (MALLOC|MPFN|MPZN)) == MALLOC) {
+			if (t1 != t2 && t1->valref == 1 && (t1->flags & (MALLOC|MPFN|MPZN|REGEX|STRVIEW)) == MALLOC) {
 				size_t nlen = t1->stlen + t2->stlen;
-
-				erealloc(t1->stptr, char *, nlen + 1);
+				int ascii = (t1->flags & t2->flags & ASCIISTR);
+
+				if ((t1->flags & STRCAP) == 0 || t1->strcap <= nlen) {
+					/* grow by doubling, as in make_str_room */
+					size_t size = 2 * (t1->stlen + 1);
+
+					if ((t1->flags & STRCAP) != 0)
+						size = 2 * t1->strcap;
+					if (size <= nlen)
+						size = nlen + 1;
+					erealloc(t1->stptr, char *, size);
+					t1->strcap = size;
+				}
 				memcpy(t1->stptr + t1->stlen, t2->stptr, t2->stlen);
 				t1->stlen = nlen;
 				t1->stptr[nlen] = '\0';
-				/* clear flags except WSTRCUR (used below) */
-				t1->flags &= WSTRCUR;
+				/* clear flags except WSTRCUR and CHARIDX (used below) */
+				t1->flags &= (WSTRCUR|CHARIDX);
 				/* configure as a string as in make_str_node */
-				t1->flags |= (MALLOC|STRING|STRCUR);
+				t1->flags |= (MALLOC|STRING|STRCUR|STRCAP);
 				t1->stfmt = STFMT_UNUSED;
 #ifdef HAVE_MPFR
 				t1->strndmode = MPFR_round_mode;
@@ -888,16 +959,17 @@ mod:
 					t1->wstptr[wlen] = L'\0';
 				} else
 					free_wstr(*lhs);
+				t1->flags |= ascii;	/* ASCII + ASCII is ASCII */
 			} else {
 				size_t nlen = t1->stlen + t2->stlen;
-				char *p;
+				int ascii = (t1->flags & t2->flags & ASCIISTR);
 
-				emalloc(p, char *, nlen + 1);
-				memcpy(p, t1->stptr, t1->stlen);
-				memcpy(p + t1->stlen, t2->stptr, t2->stlen);
-				/* N.B. No NUL-termination required, since make_str_node will do it. */
-				unref(*lhs);
-				t1 = *lhs = make_str_node(p, nlen, ALREADY_MALLOCED);
+				/* this takes over the reference from *lhs */
+				t1 = *lhs = make_str_room(*lhs, nlen);
+				memcpy(t1->stptr + t1->stlen, t2->stptr, t2->stlen);
+				t1->stlen = nlen;
+				t1->stptr[nlen] = '\0';
+				t1->flags |= ascii;
 			}
 			DEREF(t2);
 			break;
@@ -1346,6 +1418,45 @@ match_re:
 			JUMPTO(ni);	/* Op_func */
 		}
 
+		case Op_func_call_inline:
+		{
+			long arg_count = (pc + 1)->expr_count;
+
+			/*
+			 * The inlined copy of the body that follows only
+			 * knows about scalar arguments; anything else
+			 * (untyped variables, arrays) gets a real call.
+			 */
+			for (di = 0; di < arg_count; di++) {
+				if (PEEK(di)->type != Node_val)
+					break;
+			}
+			if (di == arg_count)
+				break;
+
+			if (do_itrace)
+				fprintf(stderr, "++\t%s\n", pc->func_name);
+			ni = setup_frame(pc);
+			frame_ptr->reti = (pc + 1)->inline_last;	/* skip the inlined copy on return */
+			JUMPTO(ni);	/* Op_func */
+		}
+
+		case Op_inline_return:
+			m = POP_SCALAR();	/* return value */
+			for (di = 0; di < pc->expr_count; di++) {
+				r = POP();
+				DEREF(r);
+			}
+			PUSH(m);
+			JUMPTO(pc->target_jmp);
+
+		case Op_tail_call:
+			if (do_itrace)
+				fprintf(stderr, "++\t%s\n", pc->func_name);
+			if ((ni = tail_call(pc)) == NULL)
+				ni = setup_frame(pc);
+			JUMPTO(ni);	/* Op_func */
+
 		case Op_K_return_from_eval:
 			cant_happen("unexpected opcode %s", opcode2str(op));
 			break;
@@ -79,6 +79,12 @@
 #include <sys/select.h>
 #endif	/* HAVE_SYS_SELECT_H */
 
+#if defined(HAVE_SPAWN_H) && defined(HAVE_POSIX_SPAWNP) \
+    && ! defined(__MINGW32__) && ! defined(VMS)
+#include <spawn.h>
+#define USE_POSIX_SPAWN 1
+#endif
+
 #ifndef HAVE_GETADDRINFO
 #include "missing_d/getaddrinfo.h"
 #endif
@@ -270,6 +276,12 @@ static RECVALUE (*matchrec)(IOBUF *iop, struct recmatch *recm, SCANSTATE *state)
 static int get_a_record(char **out, size_t *len, IOBUF *iop, int *errcode, const awk_fieldwidth_info_t **field_width);
 
 static void free_rp(struct redirect *rp);
+static void red_hash_insert(struct redirect *rp);
+static void red_hash_remove(struct redirect *rp);
+static struct redirect *red_hash_chain(const char *str, size_t len, size_t *code);
+static void lru_add(struct redirect *rp);
+static void lru_remove(struct redirect *rp);
+static long max_output_files(void);
 
 struct inet_socket_info {
 	int family;		/* AF_UNSPEC, AF_INET, or AF_INET6 */
@@ -297,6 +309,28 @@ static long read_timeout;
 static long read_default_timeout;
 
 static struct redirect *red_head = NULL;
+/*
+ * The redirections are also kept in a hash table keyed on the name,
+ * so that `print > $1 ".out"' doesn't have to walk the whole list.
+ */
+static struct redirect **red_table = NULL;
+static unsigned long red_table_size = 0;
+static unsigned long red_count = 0;
+#define RED_TABLE_INIT	64
+/*
+ * Output files that close_one() may close for a while when we run
+ * short of file descriptors, most recently used first.  It closes the
+ * one at the tail, which is reopened for appending when next used.
+ */
+static struct redirect *lru_head = NULL;
+static struct redirect *lru_tail = NULL;
+static long lru_count = 0;
+#define in_lru(rp)	((rp)->lru_prev != NULL || lru_head == (rp))
+
+/* counters for PROCINFO */
+static long output_opens = 0;
+static long output_evictions = 0;
+static long output_reopens = 0;
 static NODE *RS = NULL;
 static Regexp *RS_re[2];	/* index 0 - don't ignore case, index 1, do */
 static Regexp *RS_regexp;
@@ -465,6 +499,7 @@ nextfile(IOBUF **curfile, bool skipping)
 		if (arg == NULL || arg->stlen == 0)
 			continue;
 		arg = force_string(arg);
+		settle_string(arg);
 		if (! do_traditional) {
 			unref(ARGIND_node->var_value);
 			ARGIND_node->var_value = make_number(i);
@@ -854,7 +889,28 @@ redirect_string(const char *str, size_t explen, bool not_string,
 	}
 #endif /* HAVE_SOCKETS */
 
-	for (rp = red_head; rp != NULL; rp = rp->next) {
+	/*
+	 * For lint, and to reap dead children when opening an input
+	 * pipe, every redirection has to be looked at anyway.
+	 */
+	if (do_lint || redirtype == redirect_pipein)
+		rp = red_head;
+	else {
+		size_t code;
+
+		for (rp = red_hash_chain(str, explen, & code); rp != NULL; rp = rp->hnext) {
+			if (rp->hcode == code
+			    && strlen(rp->value) == explen
+			    && memcmp(rp->value, str, explen) == 0
+			    && ((rp->flag & ~(RED_FLUSH|RED_EOF|RED_PTY)) == tflag
+				|| (outflag != 0
+				    && (rp->flag & (RED_FILE|RED_WRITE)) == outflag)))
+				break;
+		}
+		goto found;
+	}
+
+	for (; rp != NULL; rp = rp->next) {
 #ifndef PIPES_SIMULATED
 		/*
 		 * This is an efficiency hack.  We want to
@@ -891,6 +947,7 @@ redirect_string(const char *str, size_t explen, bool not_string,
 		}
 	}
 
+found:
 	if (rp == NULL) {
 		char *newstr;
 		new_rp = true;
@@ -910,6 +967,7 @@ redirect_string(const char *str, size_t explen, bool not_string,
 		rp->iop = NULL;
 		rp->pid = -1;
 		rp->status = 0;
+		rp->lru_prev = rp->lru_next = NULL;
 	} else
 		str = rp->value;	/* get \0 terminated string */
 	save_rp = rp;
@@ -1017,6 +1075,11 @@ redirect_string(const char *str, size_t explen, bool not_string,
 		}
 
 		if (mode != NULL) {
+			long max_files = max_output_files();
+
+			if (max_files > 0 && lru_count >= max_files)
+				close_one();
+
 			errno = 0;
 			rp->output.mode = mode;
 			fd = (extfd >= 0) ? extfd : devopen(str, mode);
@@ -1043,6 +1106,12 @@ redirect_string(const char *str, size_t explen, bool not_string,
 					/* don't leak file descriptors */
 					if (rp->output.fp == NULL)
 						close(fd);
+					else {
+						lru_add(rp);
+						update_PROCINFO_num("output_opens", ++output_opens);
+						if ((rp->flag & RED_USED) != 0)
+							update_PROCINFO_num("output_reopens", ++output_reopens);
+					}
 				}
 				if (rp->output.fp != NULL && os_isatty(fd))
 					rp->flag |= RED_FLUSH;
@@ -1118,6 +1187,11 @@ redirect_string(const char *str, size_t explen, bool not_string,
 		rp->prev = NULL;
 		rp->next = red_head;
 		red_head = rp;
+		red_hash_insert(rp);
+	} else if (rp != lru_head && in_lru(rp)) {
+		/* most recently used goes first */
+		lru_remove(rp);
+		lru_add(rp);
 	}
 	save_rp = NULL;
 	return rp;
@@ -1140,8 +1214,21 @@ redirect(NODE *redir_exp, int redirtype, int *errflg, bool failure_fatal)
 struct redirect *
 getredirect(const char *str, int len)
 {
-	struct redirect *rp;
+	struct redirect *rp, *found = NULL;
+	size_t code;
+
+	for (rp = red_hash_chain(str, len, & code); rp != NULL; rp = rp->hnext) {
+		if (rp->hcode == code
+		    && strlen(rp->value) == len
+		    && memcmp(rp->value, str, len) == 0) {
+			if (found != NULL)
+				goto slow;	/* need the most recently used one */
+			found = rp;
+		}
+	}
+	return found;
 
+slow:
 	for (rp = red_head; rp != NULL; rp = rp->next)
 		if (strlen(rp->value) == len && memcmp(rp->value, str, len) == 0)
 			return rp;
@@ -1194,7 +1281,6 @@ static void
 close_one()
 {
 	struct redirect *rp;
-	struct redirect *rplast = NULL;
 
 	static bool warned = false;
 
@@ -1203,28 +1289,19 @@ close_one()
 		lintwarn(_("reached system limit for open files: starting to multiplex file descriptors"));
 	}
 
-	/* go to end of list first, to pick up least recently used entry */
-	for (rp = red_head; rp != NULL; rp = rp->next)
-		rplast = rp;
-	/* now work back up through the list */
-	for (rp = rplast; rp != NULL; rp = rp->prev) {
-		/* don't close standard files! */
-		if (rp->output.fp == NULL || rp->output.fp == stderr || rp->output.fp == stdout)
-			continue;
-
-		if ((rp->flag & (RED_FILE|RED_WRITE)) == (RED_FILE|RED_WRITE)) {
-			rp->flag |= RED_USED;
-			errno = 0;
-			if (rp->output.gawk_fclose(rp->output.fp, rp->output.opaque) != 0)
-				warning(_("close of `%s' failed: %s"),
-					rp->value, strerror(errno));
-			rp->output.fp = NULL;
-			break;
-		}
-	}
-	if (rp == NULL)
+	/* pick up the least recently used output file */
+	if ((rp = lru_tail) == NULL)
 		/* surely this is the only reason ??? */
 		fatal(_("too many pipes or input files open"));
+
+	lru_remove(rp);
+	rp->flag |= RED_USED;
+	errno = 0;
+	if (rp->output.gawk_fclose(rp->output.fp, rp->output.opaque) != 0)
+		warning(_("close of `%s' failed: %s"),
+			rp->value, strerror(errno));
+	rp->output.fp = NULL;
+	update_PROCINFO_num("output_evictions", ++output_evictions);
 }
 
 /* do_close --- completely close an open file or pipe */
@@ -1258,11 +1335,7 @@ do_close(int nargs)
 
 	tmp = POP_STRING(); 	/* 1st arg: redir to close */
 
-	for (rp = red_head; rp != NULL; rp = rp->next) {
-		if (strlen(rp->value) == tmp->stlen
-		    && memcmp(rp->value, tmp->stptr, tmp->stlen) == 0)
-			break;
-	}
+	rp = getredirect(tmp->stptr, tmp->stlen);
 
 	if (rp == NULL) {	/* no match, return -1 */
 		char *cp;
@@ -1344,6 +1417,8 @@ close_rp(struct redirect *rp, two_way_close_type how)
 
 		rp->output.fp = NULL;
 	} else if (rp->output.fp != NULL) {	/* write to file */
+		if (in_lru(rp))
+			lru_remove(rp);
 		status = rp->output.gawk_fclose(rp->output.fp, rp->output.opaque);
 		rp->output.fp = NULL;
 	} else if (rp->iop != NULL) {	/* read from pipe/file */
@@ -1437,6 +1512,7 @@ checkwarn:
 			rp->prev->next = rp->next;
 		else
 			red_head = rp->next;
+		red_hash_remove(rp);
 		free_rp(rp);
 	}
 
@@ -2447,7 +2523,10 @@ use_pipes:
 	}
 
 #else /* NOT __MINGW32__ */
-	if ((pid = fork()) < 0) {
+	int close_fds[] = { ptoc[0], ptoc[1], ctop[0], ctop[1], -1 };
+
+	if ((pid = spawn_shell(str, ptoc[0], ctop[1], close_fds, NULL, NULL)) < 0
+	    && (pid = fork()) < 0) {
 		save_errno = errno;
 		close(ptoc[0]); close(ptoc[1]);
 		close(ctop[0]); close(ctop[1]);
@@ -2710,7 +2789,10 @@ gawk_popen(const char *cmd, struct redirect *rp)
 	close(save_stdout);
 
 #else /* NOT __MINGW32__ */
-	if ((pid = fork()) == 0) {
+	int close_fds[] = { p[0], p[1], -1 };
+
+	if ((pid = spawn_shell(cmd, -1, p[1], close_fds, NULL, NULL)) < 0
+	    && (pid = fork()) == 0) {
 		if (close(1) == -1)
 			fatal(_("close of stdout in child failed: %s"),
 				strerror(errno));
@@ -3882,6 +3964,46 @@ find_longest_terminator:
 	return REC_OK;
 }
 
+/*
+ * csv_find_newline --- return the first newline at or after bp, flipping
+ *	*in_quote for each double quote passed over.  The caller has put a
+ *	sentinel newline at end.  With SSE2, sixteen characters are looked at
+ *	at a time: the quotes before the first newline in a block only matter
+ *	through how many of them there are.
+ */
+
+static inline char *
+csv_find_newline(char *bp, char *end, bool *in_quote)
+{
+#ifdef USE_SSE2
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i quote = _mm_set1_epi8('"');
+	unsigned int nl, qt;
+
+	for (; end - bp >= 16; bp += 16) {
+		__m128i block = _mm_loadu_si128((const __m128i *) bp);
+
+		nl = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+		qt = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(block, quote));
+		if (nl != 0) {
+			nl = __builtin_ctz(nl);
+			qt &= (1U << nl) - 1;
+			if ((__builtin_popcount(qt) & 1) != 0)
+				*in_quote = ! *in_quote;
+			return bp + nl;
+		}
+		if ((__builtin_popcount(qt) & 1) != 0)
+			*in_quote = ! *in_quote;
+	}
+#endif
+	while (*bp != '\n' && bp < end) {
+		if (*bp == '\"')
+			*in_quote = ! *in_quote;
+		bp++;
+	}
+	return bp;
+}
+
 /* csvscan --- handle --csv mode */
 
 static RECVALUE
@@ -3904,11 +4026,7 @@ csvscan(IOBUF *iop, struct recmatch *recm, SCANSTATE *state)
 
 	/* look for a newline outside quotes */
 	do {
-		while (*bp != rs && bp < iop->dataend) { 
-			if (*bp == '\"')
-				in_quote = ! in_quote;
-			bp++;
-		}
+		bp = csv_find_newline(bp, iop->dataend, & in_quote);
 		if (bp > iop->off && bp[-1] == '\r') {
 			// convert CR-LF to LF by shifting the record
 			memmove(bp - 1, bp, iop->dataend - bp);
@@ -4310,6 +4428,126 @@ free_rp(struct redirect *rp)
 	efree(rp);
 }
 
+/* red_hash_chain --- return the hash chain for str, and its hash code */
+
+static struct redirect *
+red_hash_chain(const char *str, size_t len, size_t *code)
+{
+	(void) hash(str, len, 1, code);
+	if (red_table == NULL)
+		return NULL;
+	return red_table[*code % red_table_size];
+}
+
+/* red_hash_insert --- add rp to the hash table, growing it if need be */
+
+static void
+red_hash_insert(struct redirect *rp)
+{
+	struct redirect **bucket;
+
+	if (red_count >= red_table_size) {
+		unsigned long i, newsize;
+		struct redirect **newtable;
+		struct redirect *p, *next;
+
+		newsize = (red_table_size == 0) ? RED_TABLE_INIT : red_table_size * 2;
+		ezalloc(newtable, struct redirect **, newsize * sizeof(struct redirect *));
+		for (i = 0; i < red_table_size; i++) {
+			for (p = red_table[i]; p != NULL; p = next) {
+				next = p->hnext;
+				bucket = & newtable[p->hcode % newsize];
+				p->hnext = *bucket;
+				*bucket = p;
+			}
+		}
+		if (red_table != NULL)
+			efree(red_table);
+		red_table = newtable;
+		red_table_size = newsize;
+	}
+
+	(void) hash(rp->value, strlen(rp->value), 1, & rp->hcode);
+	bucket = & red_table[rp->hcode % red_table_size];
+	rp->hnext = *bucket;
+	*bucket = rp;
+	red_count++;
+}
+
+/* red_hash_remove --- take rp out of the hash table */
+
+static void
+red_hash_remove(struct redirect *rp)
+{
+	struct redirect **pp;
+
+	for (pp = & red_table[rp->hcode % red_table_size]; *pp != NULL; pp = & (*pp)->hnext) {
+		if (*pp == rp) {
+			*pp = rp->hnext;
+			red_count--;
+			return;
+		}
+	}
+	cant_happen("redirection `%s' missing from hash table", rp->value);
+}
+
+/* lru_add --- put an open output file at the head of the LRU list */
+
+static void
+lru_add(struct redirect *rp)
+{
+	rp->lru_prev = NULL;
+	rp->lru_next = lru_head;
+	if (lru_head != NULL)
+		lru_head->lru_prev = rp;
+	else
+		lru_tail = rp;
+	lru_head = rp;
+	lru_count++;
+}
+
+/* lru_remove --- take an output file off the LRU list */
+
+static void
+lru_remove(struct redirect *rp)
+{
+	if (rp->lru_prev != NULL)
+		rp->lru_prev->lru_next = rp->lru_next;
+	else
+		lru_head = rp->lru_next;
+	if (rp->lru_next != NULL)
+		rp->lru_next->lru_prev = rp->lru_prev;
+	else
+		lru_tail = rp->lru_prev;
+	rp->lru_prev = rp->lru_next = NULL;
+	lru_count--;
+}
+
+/* max_output_files --- return PROCINFO["MAX_OUTPUT_FILES"], or 0 if not set */
+
+static long
+max_output_files()
+{
+	NODE *val;
+
+	if (PROCINFO_node == NULL
+	    || (val = in_PROCINFO("MAX_OUTPUT_FILES", NULL, NULL)) == NULL)
+		return 0;
+
+	(void) force_number(val);
+	return get_number_si(val);
+}
+
+/* update_output_stats --- put the output file counters into PROCINFO */
+
+void
+update_output_stats()
+{
+	update_PROCINFO_num("output_opens", output_opens);
+	update_PROCINFO_num("output_evictions", output_evictions);
+	update_PROCINFO_num("output_reopens", output_reopens);
+}
+
 /* inetfile --- return true for a /inet special file, set other values */
 
 static bool
@@ -4689,6 +4927,82 @@ save_pipe(int fd, FILE *fp, pid_t pid)
 #endif /* PIPE_HASH_SIZE */
 
 
+/*
+ * spawn_shell --- run `/bin/sh -c command' with posix_spawn().  Unlike
+ *	fork(), that doesn't copy gawk's address space, so it costs the same
+ *	however big the arrays are.  The child's standard input and output
+ *	come from child_in and child_out unless they are -1, and the
+ *	descriptors in close_fds (ended by -1) are closed in the child.
+ *	SIGPIPE and the signals in sigdefault get their default actions,
+ *	and the child's signal mask is sigmask if that isn't NULL.
+ *	Returns -1 if the child couldn't be started this way, in which
+ *	case the caller should fork() as usual.
+ */
+
+pid_t
+spawn_shell(const char *command, int child_in, int child_out,
+		const int *close_fds, const sigset_t *sigmask,
+		const sigset_t *sigdefault)
+{
+#ifdef USE_POSIX_SPAWN
+	extern char **environ;
+	posix_spawn_file_actions_t actions;
+	posix_spawnattr_t attr;
+	sigset_t dflt;
+	short flags = POSIX_SPAWN_SETSIGDEF;
+	char *argv[4];
+	pid_t pid;
+	int i, ret = 0;
+
+	if (posix_spawn_file_actions_init(& actions) != 0)
+		return -1;
+	if (posix_spawnattr_init(& attr) != 0) {
+		posix_spawn_file_actions_destroy(& actions);
+		return -1;
+	}
+
+	if (child_out >= 0)
+		ret |= posix_spawn_file_actions_adddup2(& actions, child_out, 1);
+	if (child_in >= 0)
+		ret |= posix_spawn_file_actions_adddup2(& actions, child_in, 0);
+	for (i = 0; close_fds[i] >= 0; i++) {
+		/* don't close what was just put in place */
+		if ((close_fds[i] == 1 && child_out >= 0)
+		    || (close_fds[i] == 0 && child_in >= 0))
+			continue;
+		ret |= posix_spawn_file_actions_addclose(& actions, close_fds[i]);
+	}
+
+	if (sigdefault != NULL)
+		dflt = *sigdefault;
+	else
+		sigemptyset(& dflt);
+#ifdef SIGPIPE
+	sigaddset(& dflt, SIGPIPE);
+#endif
+	ret |= posix_spawnattr_setsigdefault(& attr, & dflt);
+	if (sigmask != NULL) {
+		flags |= POSIX_SPAWN_SETSIGMASK;
+		ret |= posix_spawnattr_setsigmask(& attr, sigmask);
+	}
+	ret |= posix_spawnattr_setflags(& attr, flags);
+
+	argv[0] = (char *) "sh";
+	argv[1] = (char *) "-c";
+	argv[2] = (char *) command;
+	argv[3] = NULL;
+	if (ret == 0)
+		ret = posix_spawn(& pid, "/bin/sh", & actions, & attr, argv, environ);
+
+	posix_spawnattr_destroy(& attr);
+	posix_spawn_file_actions_destroy(& actions);
+
+	return (ret == 0) ? pid : -1;
+#else
+	return -1;
+#endif
+}
+
 /* gawk_popen_write --- open a pipe for writing, set up a FILE * return value. */
 
 static FILE *
@@ -4714,7 +5028,10 @@ gawk_popen_write(const char *cmd)
 		memset(open_pipes, 0, sizeof(write_pipe) * count);
 	}
 
-	childpid = fork();
+	int close_fds[] = { pipefds[0], pipefds[1], -1 };
+
+	if ((childpid = spawn_shell(cmd, pipefds[0], -1, close_fds, NULL, NULL)) < 0)
+		childpid = fork();
 	if (childpid == 0) {
 		// in the child
 		(void) close(pipefds[1]);	// close write end in the child
@@ -52,6 +52,10 @@ static void catchsig(int sig);
 static void version(void) ATTRIBUTE_NORETURN;
 static void init_fds(void);
 static void init_groupset(void);
+static double time_now(void);
+static void note_startup_time(const char *name, double secs);
+static void startup_step(const char *name);
+static void print_startup_trace(void);
 static void save_argv(int, char **);
 static const char *platform_name();
 #ifdef USE_PERSISTENT_MALLOC
@@ -140,6 +144,11 @@ bool do_itrace = false;			/* provide simple instruction trace */
 bool do_optimize = true;		/* apply default optimizations */
 static int do_binary = false;		/* hands off my data! */
 static int do_version = false;		/* print version info */
+static int do_startup_trace = false;	/* time the steps of initialization */
+static bool lazy_init = false;		/* load ENVIRON etc. on first use */
+static bool parse_done = false;		/* the program has been parsed */
+static bool lazy_builtins = false;	/* builtins not yet in FUNCTAB */
+static bool builtins_wanted = false;	/* install them right after parsing */
 static const char *locale = "";		/* default value to setlocale */
 static const char *locale_dir = LOCALEDIR;	/* default locale dir */
 #ifdef USE_PERSISTENT_MALLOC
@@ -199,6 +208,7 @@ static const struct option optab[] = {
 	{ "profile",		optional_argument,	NULL,	'p' },
 	{ "sandbox",		no_argument,		NULL, 	'S' },
 	{ "source",		required_argument,	NULL,	'e' },
+	{ "startup-trace",	no_argument,		& do_startup_trace, 1 },
 	{ "trace",		no_argument,		NULL,	'I' },
 	{ "traditional",	no_argument,		NULL,	'c' },
 	{ "use-lc-numeric",	no_argument,		& use_lc_numeric, 1 },
@@ -219,6 +229,7 @@ main(int argc, char **argv)
 	const char *initial_locale;
 #endif
 
+	startup_step(NULL);
 	myname = gawk_name(argv[0]);
 
 	using_persistent_malloc = enable_pma(argv);
@@ -249,6 +260,7 @@ main(int argc, char **argv)
 	initial_locale = locale;
 #endif
 	set_locale_stuff();
+	startup_step("locale");
 
 	(void) signal(SIGSEGV, catchsig);
 	(void) signal(SIGFPE, catchsig);
@@ -287,8 +299,10 @@ main(int argc, char **argv)
 
 	/* initialize global (main) execution context */
 	push_context(new_context());
+	startup_step("tables");
 
 	parse_args(argc, argv);
+	startup_step("options");
 
 	if (getenv("GAWK_GNU_MATCHERS") != NULL)
 		use_gnu_matchers = true;
@@ -315,6 +329,7 @@ main(int argc, char **argv)
 	/* set up the single byte case table */
 	if (gawk_mb_cur_max == 1)
 		load_casetable();
+	startup_step("ctype");
 
 	/* check for POSIXLY_CORRECT environment variable */
 	if (! do_posix && getenv("POSIXLY_CORRECT") != NULL) {
@@ -371,9 +386,6 @@ main(int argc, char **argv)
 		init_mpfr(DEFAULT_PREC, DEFAULT_ROUNDMODE);
 #endif
 
-	/* load group set */
-	init_groupset();
-
 #ifdef HAVE_MPFR
 	if (do_mpfr) {
 		mpz_init(Nnull_string->mpg_i);
@@ -394,6 +406,7 @@ main(int argc, char **argv)
 
 	/* Set up the special variables */
 	init_vars();
+	startup_step("variables");
 
 	/* set up CSV */
 	init_csv_records();
@@ -414,6 +427,7 @@ main(int argc, char **argv)
 
 	if (preassigns != NULL)
 		efree(preassigns);
+	startup_step("fields");
 
 	if ((BINMODE & BINMODE_INPUT) != 0)
 		if (os_setbinmode(fileno(stdin), O_BINARY) == -1)
@@ -445,6 +459,8 @@ main(int argc, char **argv)
 			have_srcfile = true;
 	}
 
+	startup_step("extensions");
+
 	/* do version check after extensions are loaded to get extension info */
 	if (do_version)
 		version();
@@ -463,6 +479,7 @@ main(int argc, char **argv)
 	init_args(optind, argc,
 			do_posix ? argv[0] : myname,
 			argv);
+	startup_step("ARGV");
 
 #if defined(LC_NUMERIC)
 	/*
@@ -475,13 +492,18 @@ main(int argc, char **argv)
 	/* Read in the program */
 	if (parse_program(& code_block, false) != 0 || dash_v_errs > 0)
 		exit(EXIT_FAILURE);
+	startup_step("parse");
 
 	if (do_intl)
 		exit(EXIT_SUCCESS);
 
 	set_current_namespace(awk_namespace);
 
-	install_builtins();
+	parse_done = true;
+	if (! lazy_init || builtins_wanted)
+		install_builtins();
+	else
+		lazy_builtins = true;
 
 	if (do_lint)
 		shadow_funcs();
@@ -493,6 +515,7 @@ main(int argc, char **argv)
 
 	if (do_profile)
 		init_profiling_signals();
+	startup_step("symbols");
 
 #if defined(LC_NUMERIC)
 	/*
@@ -516,6 +539,8 @@ main(int argc, char **argv)
 
 	init_io();
 	output_fp = stdout;
+	startup_step("I/O");
+	print_startup_trace();
 
 	if (do_debug)
 		debug_prog(code_block);
@@ -622,6 +647,7 @@ usage(int exitval, FILE *fp)
 	fputs(_("\t-P\t\t\t--posix\n"), fp);
 	fputs(_("\t-s\t\t\t--no-optimize\n"), fp);
 	fputs(_("\t-S\t\t\t--sandbox\n"), fp);
+	fputs(_("\t\t\t\t--startup-trace\n"), fp);
 	fputs(_("\t-V\t\t\t--version\n"), fp);
 #ifdef GAWKDEBUG
 	fputs(_("\t-Y\t\t\t--parsedebug\n"), fp);
@@ -851,12 +877,67 @@ init_vars()
 			(*(vp->assign))();
 	}
 
-	/* Load PROCINFO and ENVIRON */
+	/*
+	 * Load PROCINFO and ENVIRON.  Unless all the variables are going to
+	 * be looked at anyway, this waits until the program uses them;
+	 * see load_lazy_symbol().  The persistent memory case keeps the old
+	 * arrays around, so they have to be reloaded every time.
+	 */
+	lazy_init = ! (using_persistent_malloc || do_lint || do_dump_vars || do_debug);
+	if (lazy_init)
+		return;
+
 	if (! do_traditional)
 		load_procinfo();
 	load_environ();
 }
 
+/*
+ * load_lazy_symbol --- called by lookup() when name is not found, or with
+ *	NULL for SYMTAB and FUNCTAB, which can get at anything.  Load the
+ *	ENVIRON or PROCINFO array, and put the builtins into FUNCTAB, if that
+ *	is still to be done.  Return true if something was loaded.
+ */
+
+bool
+load_lazy_symbol(const char *name)
+{
+	bool loaded = false;
+	double start;
+
+	if (! lazy_init)
+		return false;
+
+	/* PROCINFO["identifiers"] lists everything, so load it all */
+	if (name != NULL && strcmp(name, "PROCINFO") == 0)
+		name = NULL;
+
+	if (! parse_done) {
+		if (name == NULL)
+			builtins_wanted = true;
+	} else if (lazy_builtins) {
+		lazy_builtins = false;
+		install_builtins();
+		loaded = true;
+	}
+
+	if (ENVIRON_node == NULL && (name == NULL || strcmp(name, "ENVIRON") == 0)) {
+		start = time_now();
+		(void) load_environ();
+		note_startup_time("ENVIRON", time_now() - start);
+		loaded = true;
+	}
+
+	if (PROCINFO_node == NULL && ! do_traditional && name == NULL) {
+		start = time_now();
+		(void) load_procinfo();
+		note_startup_time("PROCINFO", time_now() - start);
+		loaded = true;
+	}
+
+	return loaded;
+}
+
 /* path_environ --- put path variable into environment if not already there */
 
 static void
@@ -996,6 +1077,9 @@ load_procinfo()
 
 	PROCINFO_node = install_symbol(estrdup("PROCINFO", 8), Node_var_array);
 
+	/* load group set */
+	init_groupset();
+
 	update_PROCINFO_str("version", VERSION);
 	update_PROCINFO_str("strftime", def_strftime_format);
 	update_PROCINFO_str("platform", platform_name());
@@ -1048,6 +1132,7 @@ load_procinfo()
 	update_PROCINFO_num("egid", value);
 
 	update_PROCINFO_str("FS", current_field_sep_str());
+	update_output_stats();
 
 #if defined (HAVE_GETGROUPS) && defined(NGROUPS_MAX) && NGROUPS_MAX > 0
 	for (i = 0; i < ngroups; i++) {
@@ -1069,6 +1154,11 @@ load_procinfo()
 		update_PROCINFO_num("CSV", 1);
 
 	load_procinfo_argv();
+
+	/* main() did this already if PROCINFO was used while parsing */
+	if (parse_done)
+		load_symbols();
+
 	return PROCINFO_node;
 }
 
@@ -1420,6 +1510,124 @@ init_groupset()
 #endif
 }
 
+/*
+ * --startup-trace support.  Each step of the initialization done by main()
+ * is timed; the option is only known once the arguments have been parsed,
+ * so the times are kept until everything is ready, and then printed.
+ */
+
+#define MAX_STARTUP_STEPS	32
+
+static struct startup_time {
+	const char *name;
+	double secs;
+	bool nested;	/* happened during one of the steps */
+} startup_times[MAX_STARTUP_STEPS];
+static int num_startup_times;
+static bool startup_done = false;
+static double startup_start;	/* when the first step began */
+static double step_start;	/* when the current step began */
+
+/* time_now --- the current time in seconds */
+
+static double
+time_now(void)
+{
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+	struct timespec now;
+
+	(void) clock_gettime(CLOCK_MONOTONIC, & now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+#elif defined(HAVE_GETTIMEOFDAY)
+	struct timeval now;
+
+	(void) gettimeofday(& now, NULL);
+	return now.tv_sec + now.tv_usec / 1e6;
+#else
+	return (double) time(NULL);
+#endif
+}
+
+/* add_startup_time --- remember a time for print_startup_trace() */
+
+static void
+add_startup_time(const char *name, double secs, bool nested)
+{
+	if (num_startup_times < MAX_STARTUP_STEPS) {
+		startup_times[num_startup_times].name = name;
+		startup_times[num_startup_times].secs = secs;
+		startup_times[num_startup_times].nested = nested;
+		num_startup_times++;
+	}
+}
+
+/*
+ * note_startup_time --- record how long something loaded on demand took.
+ * Before the program runs this is always within one of the steps, so the
+ * time is already part of that step's.
+ */
+
+static void
+note_startup_time(const char *name, double secs)
+{
+	if (startup_done) {
+		/* loaded on first use while running */
+		if (do_startup_trace)
+			fprintf(stderr, "%s: init: %-12s %9.3f ms\n",
+					myname, name, secs * 1000.0);
+		return;
+	}
+
+	add_startup_time(name, secs, true);
+}
+
+/* startup_step --- end the current step of initialization, NULL for the first */
+
+static void
+startup_step(const char *name)
+{
+	double now = time_now();
+
+	if (name != NULL)
+		add_startup_time(name, now - step_start, false);
+	else
+		startup_start = now;
+	step_start = now;
+}
+
+/* print_startup_trace --- print the times for --startup-trace */
+
+static void
+print_startup_trace(void)
+{
+	int i, j;
+
+	startup_done = true;
+	if (! do_startup_trace)
+		return;
+
+	for (i = 0; i < num_startup_times; i++) {
+		if (! startup_times[i].nested) {
+			fprintf(stderr, "%s: init: %-12s %9.3f ms\n", myname,
+					startup_times[i].name, startup_times[i].secs * 1000.0);
+			continue;
+		}
+
+		/* the step it happened in is the next one to finish */
+		for (j = i + 1; j < num_startup_times; j++)
+			if (! startup_times[j].nested)
+				break;
+		fprintf(stderr, "%s: init:   %-10s %9.3f ms", myname,
+				startup_times[i].name, startup_times[i].secs * 1000.0);
+		if (j < num_startup_times)
+			fprintf(stderr, " (in %s)", startup_times[j].name);
+		putc('\n', stderr);
+	}
+	fprintf(stderr, "%s: init: %-12s %9.3f ms\n", myname, "total",
+			(step_start - startup_start) * 1000.0);
+	fflush(stderr);
+}
+
 /* estrdup --- duplicate a string */
 
 char *
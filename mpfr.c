@@ -449,7 +449,7 @@ mpg_format_val(const char *format, int index, int fmtflag, NODE *s)
 	s->flags = oflags;
 	s->stlen = r->stlen;
 	if ((s->flags & (MALLOC|STRCUR)) == (MALLOC|STRCUR))
-		efree(s->stptr);
+		free_stptr(s);
 	s->stptr = r->stptr;
 	s->flags &= ~(CONVFMT_FMT|OFMT_FMT);
 	s->flags |= STRCUR | fmtflag;
@@ -34,6 +34,17 @@ NODE *(*str2number)(NODE *) = r_force_number;
 NODE *(*format_val)(const char *, int, int, NODE *) = r_format_val;
 int (*cmp_numbers)(const NODE *, const NODE *) = cmp_awknums;
 
+/*
+ * Powers of ten that are exact as doubles.  Multiplying or dividing by
+ * one of these rounds only once.
+ */
+static const double exact_pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+	1e21, 1e22,
+};
+#define MAX_EXACT_POW10	22
+
 /* is_hex --- return true if a string looks like a hex value */
 
 static bool
@@ -49,6 +60,75 @@ is_hex(const char *str, const char *cpend)
 	return false;
 }
 
+/*
+ * fast_strtod --- convert a plain decimal number that takes up all of
+ *	[cp, cpend), the way strtod() would.  If the significant digits
+ *	make an integer no bigger than 2^53 and the power of ten is exact,
+ *	one multiplication or division gives the correctly rounded result.
+ *	Return false for anything else, which is left to strtod().
+ */
+
+static bool
+fast_strtod(const char *cp, const char *cpend, double *result)
+{
+	uintmax_t mant = 0;
+	int ndigits = 0, exp10 = 0, e = 0;
+	bool negative = false, seen_digit = false, negative_exp = false;
+	double val;
+
+	if (*cp == '-' || *cp == '+')
+		negative = (*cp++ == '-');
+
+	for (; cp < cpend && isdigit((unsigned char) *cp); cp++) {
+		seen_digit = true;
+		if (mant == 0 && *cp == '0')
+			continue;	/* leading zero */
+		if (++ndigits > 19)
+			return false;
+		mant = mant * 10 + (*cp - '0');
+	}
+	if (cp < cpend && *cp == '.') {
+		for (cp++; cp < cpend && isdigit((unsigned char) *cp); cp++) {
+			seen_digit = true;
+			exp10--;
+			if (mant == 0 && *cp == '0')
+				continue;
+			if (++ndigits > 19)
+				return false;
+			mant = mant * 10 + (*cp - '0');
+		}
+	}
+	if (! seen_digit)
+		return false;
+
+	if (cp < cpend && (*cp == 'e' || *cp == 'E')) {
+		cp++;
+		if (cp < cpend && (*cp == '-' || *cp == '+'))
+			negative_exp = (*cp++ == '-');
+		if (cp == cpend || ! isdigit((unsigned char) *cp))
+			return false;
+		for (; cp < cpend && isdigit((unsigned char) *cp); cp++)
+			if ((e = e * 10 + (*cp - '0')) > 1000)
+				return false;
+		exp10 += negative_exp ? -e : e;
+	}
+	if (cp != cpend)
+		return false;
+
+	if (mant == 0)
+		val = 0.0;
+	else if (mant > ((uintmax_t) 1 << 53)
+			|| exp10 > MAX_EXACT_POW10 || exp10 < -MAX_EXACT_POW10)
+		return false;
+	else if (exp10 >= 0)
+		val = (double) mant * exact_pow10[exp10];
+	else
+		val = (double) mant / exact_pow10[-exp10];
+
+	*result = negative ? -val : val;
+	return true;
+}
+
 /* force_number --- force a value to be numeric */
 
 NODE *
@@ -93,6 +173,17 @@ r_force_number(NODE *n)
 	while (isspace((unsigned char) cpend[-1]))
 		cpend--;
 
+	/*
+	 * Plain decimal numbers are by far the most common; convert
+	 * them directly, without the checks below or strtod().
+	 */
+	if (! do_non_decimal_data && ! use_lc_numeric
+			&& fast_strtod(cp, cpend, & n->numbr)) {
+		if (n->stlen == 1)	/* a single digit */
+			n->flags |= NUMINT;
+		goto goodnum;
+	}
+
 	/*
 	 * 2/2007:
 	 * POSIX, by way of severe language lawyering, seems to
@@ -201,6 +292,200 @@ static const char *values[] = {
 };
 #define	NVAL	(sizeof(values)/sizeof(values[0]))
 
+/* largest scaled value for which rounding to an integer is done here */
+#define MAX_SCALED	1e15
+
+/*
+ * round_scaled --- round val * 10^k to an integer.  The product is off
+ *	by at most half a unit in the last place, so unless it is that close
+ *	to halfway between two integers, rounding it gives the same integer
+ *	as rounding the exact value, as printf() does.  Return false for the
+ *	cases that are too close to call.
+ */
+
+static bool
+round_scaled(double val, int k, uintmax_t *result)
+{
+	double scaled, half;
+
+	if (k > MAX_EXACT_POW10 || k < -MAX_EXACT_POW10)
+		return false;
+	scaled = (k >= 0) ? val * exact_pow10[k] : val / exact_pow10[-k];
+	if (scaled >= MAX_SCALED)
+		return false;
+
+	half = floor(scaled) + 0.5;
+	if (fabs(scaled - half) <= scaled * (2 * DBL_EPSILON))
+		return false;
+
+	*result = (uintmax_t) floor(scaled + 0.5);
+	return true;
+}
+
+/*
+ * format_double --- format a value that is not an integer with "%.<n>g"
+ *	or "%.<n>f", by far the most common values of CONVFMT and OFMT, the
+ *	same way sprintf() does but without going through format_args().
+ *	Return the length of the result in buf, or -1 if the format or the
+ *	value has to be left to format_args().
+ */
+
+static int
+format_double(const char *format, double val, char *buf)
+{
+	char digits[32];
+	char *cp = buf;
+	const char *fp;
+	uintmax_t r, low, high;
+	int prec = 6;
+	int exp = 0, ndigits, last, i;
+	char conv;
+
+	if (format[0] != '%' || use_lc_numeric)
+		return -1;
+	fp = format + 1;
+	if (*fp == '.') {
+		prec = 0;
+		while (isdigit((unsigned char) *++fp))
+			if ((prec = prec * 10 + *fp - '0') > MAX_EXACT_POW10)
+				return -1;
+	}
+	conv = *fp++;
+	if ((conv != 'g' && conv != 'f') || *fp != '\0' || val == 0)
+		return -1;
+
+	if (val < 0) {
+		*cp++ = '-';
+		val = -val;
+	}
+
+	if (conv == 'f') {
+		if (! round_scaled(val, prec, & r))
+			return -1;
+		ndigits = prec + 1;	/* at least one digit before the point */
+	} else {
+		if (prec == 0)
+			prec = 1;
+		if (prec > 15)
+			return -1;
+		low = (uintmax_t) exact_pow10[prec - 1];
+		high = (uintmax_t) exact_pow10[prec];
+
+		/* log10() may be off by one, so check the number of digits */
+		exp = (int) floor(log10(val));
+		if (! round_scaled(val, prec - 1 - exp, & r))
+			return -1;
+		if (r < low || r > high) {
+			exp += (r < low) ? -1 : 1;
+			if (! round_scaled(val, prec - 1 - exp, & r)
+					|| r < low || r > high)
+				return -1;
+		}
+		if (r == high) {	/* rounded up to the next power of ten */
+			r = low;
+			exp++;
+		}
+		ndigits = prec;
+	}
+
+	/* the digits of r, padded with zeros on the left to ndigits */
+	for (i = sizeof(digits); r != 0 || (int) sizeof(digits) - i < ndigits; r /= 10)
+		digits[--i] = '0' + r % 10;
+	ndigits = (int) sizeof(digits) - i;
+	memmove(digits, digits + i, ndigits);
+
+	if (conv == 'f') {
+		memcpy(cp, digits, ndigits - prec);
+		cp += ndigits - prec;
+		if (prec > 0) {
+			*cp++ = '.';
+			memcpy(cp, digits + ndigits - prec, prec);
+			cp += prec;
+		}
+		*cp = '\0';
+		return cp - buf;
+	}
+
+	/* %g drops trailing zeros after the decimal point */
+	for (last = ndigits; last > 1 && digits[last - 1] == '0'; last--)
+		continue;
+
+	if (exp < -4 || exp >= prec) {
+		*cp++ = digits[0];
+		if (last > 1) {
+			*cp++ = '.';
+			memcpy(cp, digits + 1, last - 1);
+			cp += last - 1;
+		}
+		*cp++ = 'e';
+		*cp++ = (exp < 0) ? '-' : '+';
+		if (exp < 0)
+			exp = -exp;
+		if (exp >= 100)
+			*cp++ = '0' + exp / 100;
+		*cp++ = '0' + exp / 10 % 10;
+		*cp++ = '0' + exp % 10;
+	} else if (exp >= 0) {
+		memcpy(cp, digits, exp + 1);
+		cp += exp + 1;
+		if (last > exp + 1) {
+			*cp++ = '.';
+			memcpy(cp, digits + exp + 1, last - exp - 1);
+			cp += last - exp - 1;
+		}
+	} else {
+		*cp++ = '0';
+		*cp++ = '.';
+		for (i = exp + 1; i < 0; i++)
+			*cp++ = '0';
+		memcpy(cp, digits, last);
+		cp += last;
+	}
+	*cp = '\0';
+	return cp - buf;
+}
+
+/*
+ * fast_itoa --- write the decimal digits of num so that they end just
+ *	before bufend, two digits at a time.  There must be room for
+ *	ITOA_BUFSIZE - 1 characters.  Returns a pointer to the first one.
+ */
+
+char *
+fast_itoa(intmax_t num, char *bufend)
+{
+	static const char pairs[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+	uintmax_t u = (num < 0) ? - (uintmax_t) num : (uintmax_t) num;
+	const char *p;
+	char *cp = bufend;
+
+	while (u >= 100) {
+		p = pairs + 2 * (u % 100);
+		u /= 100;
+		*--cp = p[1];
+		*--cp = p[0];
+	}
+	if (u >= 10) {
+		p = pairs + 2 * u;
+		*--cp = p[1];
+		*--cp = p[0];
+	} else
+		*--cp = '0' + u;
+	if (num < 0)
+		*--cp = '-';
+	return cp;
+}
+
 /* r_format_val --- format a numeric value based on format */
 
 NODE *
@@ -209,6 +494,7 @@ r_format_val(const char *format, int index, int fmtflag, NODE *s)
 	char buf[BUFSIZ];
 	char *sp = buf;
 	double val;
+	int len;
 
 	/*
 	 * 2/2007: Simplify our lives here. Instead of worrying about
@@ -231,6 +517,17 @@ r_format_val(const char *format, int index, int fmtflag, NODE *s)
 		const char *result = format_nan_inf(s, 'g');
 		return make_string(result, strlen(result));
 	} else if ((val = double_to_int(s->numbr)) != s->numbr
+			&& (len = format_double(format, s->numbr, buf)) >= 0
+	) {
+		/* the usual case, done directly */
+		s->stlen = len;
+		s->stfmt = index;
+		s->flags &= ~(CONVFMT_FMT|OFMT_FMT);
+		s->flags |= fmtflag;
+#ifdef HAVE_MPFR
+		s->strndmode = MPFR_round_mode;
+#endif
+	} else if (val != s->numbr
 			|| val <= (double)LONG_MIN || val >= (double)LONG_MAX
 	) {
 		/* not an integral value, or out of integer range */
@@ -264,7 +561,7 @@ r_format_val(const char *format, int index, int fmtflag, NODE *s)
 		s->flags = oflags;
 		s->stlen = r->stlen;
 		if ((s->flags & (MALLOC|STRCUR)) == (MALLOC|STRCUR))
-			efree(s->stptr);
+			free_stptr(s);
 		s->stptr = r->stptr;
 #ifdef HAVE_MPFR
 		s->strndmode = MPFR_round_mode;
@@ -282,8 +579,9 @@ r_format_val(const char *format, int index, int fmtflag, NODE *s)
 			sp = (char *) values[num];
 			s->stlen = 1;
 		} else {
-			(void) sprintf(sp, "%ld", num);
-			s->stlen = strlen(sp);
+			sp = fast_itoa(num, buf + ITOA_BUFSIZE - 1);
+			buf[ITOA_BUFSIZE - 1] = '\0';
+			s->stlen = buf + ITOA_BUFSIZE - 1 - sp;
 		}
 		s->stfmt = STFMT_UNUSED;
 		if ((s->flags & INTIND) != 0) {
@@ -295,7 +593,7 @@ r_format_val(const char *format, int index, int fmtflag, NODE *s)
 #endif
 	}
 	if ((s->flags & (MALLOC|STRCUR)) == (MALLOC|STRCUR))
-		efree(s->stptr);
+		free_stptr(s);
 	emalloc(s->stptr, char *, s->stlen + 1);
 	memcpy(s->stptr, sp, s->stlen + 1);
 no_malloc:
@@ -335,6 +633,7 @@ r_dupnode(NODE *n)
 #endif
 
 	r->flags |= MALLOC;
+	r->flags &= ~(CHARIDX|STRCAP);
 	r->valref = 1;
 	/*
 	 * DON'T call free_wstr(r) here!
@@ -499,6 +798,150 @@ make_str_node(const char *s, size_t len, int flags)
 	return r;
 }
 
+/*
+ * make_str_view --- make a string of the len bytes at s, which are part
+ * of the string value of n.
+ *
+ * When the text is sure to stay where it is for as long as its owner
+ * lives, the new node points into it and holds a reference on the
+ * owner, instead of copying.  Such a view is not NUL-terminated, just
+ * like a field.  It is given its own copy when it is stored in a
+ * variable or an array, so that a short piece never keeps a long
+ * string alive for long.
+ */
+
+NODE *
+make_str_view(NODE *n, const char *s, size_t len)
+{
+	NODE *owner = NULL;
+	NODE *r;
+
+	if ((n->flags & STRVIEW) != 0)
+		owner = n->strparent;
+	else if ((n->flags & (MALLOC|STRING|STRCUR|REGEX|MPFN|MPZN))
+			== (MALLOC|STRING|STRCUR)
+		 && n->stfmt == STFMT_UNUSED)
+		owner = n;	/* its text is never regenerated */
+	else if ((n->flags & MALLOC) == 0 && len > 0)
+		owner = record_owner(s, len);	/* $0 or a field */
+
+	if (   owner == NULL || len == 0
+	    || s < owner->stptr || s + len > owner->stptr + owner->stlen)
+		return make_string(s, len);
+
+	getnode(r);
+	memset(r, '\0', sizeof(NODE));
+	r->type = Node_val;
+	r->flags = (MALLOC|STRING|STRCUR|STRVIEW) | (owner->flags & ASCIISTR);
+	r->valref = 1;
+	r->stfmt = STFMT_UNUSED;
+#ifdef HAVE_MPFR
+	r->strndmode = MPFR_round_mode;
+#endif
+	r->stptr = (char *) s;
+	r->stlen = len;
+	r->strparent = owner;
+	owner->valref++;
+
+	return r;
+}
+
+/* unshare_string --- give a view its own copy of its text */
+
+void
+unshare_string(NODE *n)
+{
+	char *s;
+
+	assert((n->flags & STRVIEW) != 0);
+
+	emalloc(s, char *, n->stlen + 1);
+	memcpy(s, n->stptr, n->stlen);
+	s[n->stlen] = '\0';
+	free_stptr(n);
+	n->stptr = s;
+}
+
+/*
+ * make_str_room --- return a string node that starts with the text of n
+ * and has room for len bytes in all, for a concatenation onto n to fill
+ * in.  Its stlen is that of n; the caller sets the final length and the
+ * terminator.  This takes over the caller's reference to n.
+ *
+ * The buffers made here remember their size (STRCAP) and grow by doubling,
+ * so that building a long string a piece at a time takes linear time even
+ * when each piece is added by a separate statement or function call.
+ * If nothing else refers to n, n itself is grown and returned.  Otherwise,
+ * if there is room left after the text of n, the result takes over the
+ * buffer and n becomes a view of the result: its text stays where it is,
+ * but it is no longer NUL-terminated.
+ */
+
+NODE *
+make_str_room(NODE *n, size_t len)
+{
+	NODE *r;
+	size_t size;
+	bool own = (n->valref == 1
+		&& (n->flags & (MALLOC|STRING|STRCUR|STRVIEW|REGEX|MPFN|MPZN))
+				== (MALLOC|STRING|STRCUR)
+		&& n->stfmt == STFMT_UNUSED);
+
+	if ((n->flags & STRCAP) != 0 && n->strcap > len) {
+		if (own)
+			goto reuse;
+
+		getnode(r);
+		memset(r, '\0', sizeof(NODE));
+		r->type = Node_val;
+		r->flags = (MALLOC|STRING|STRCUR|STRCAP);
+		r->valref = 2;		/* the caller's and n's */
+		r->stfmt = STFMT_UNUSED;
+#ifdef HAVE_MPFR
+		r->strndmode = MPFR_round_mode;
+#endif
+		r->stptr = n->stptr;
+		r->stlen = n->stlen;
+		r->strcap = n->strcap;
+
+		n->flags &= ~STRCAP;
+		n->flags |= STRVIEW;
+		n->strparent = r;
+		n->valref--;		/* can't reach zero */
+		return r;
+	}
+
+	size = len + 1;
+	if ((n->flags & STRCAP) != 0 && size < n->strcap * 2)
+		size = n->strcap * 2;
+
+	if (own) {
+		erealloc(n->stptr, char *, size);
+		n->strcap = size;
+	reuse:
+		free_wstr(n);
+		n->flags = (MALLOC|STRING|STRCUR|STRCAP);
+		return n;
+	}
+
+	getnode(r);
+	memset(r, '\0', sizeof(NODE));
+	r->type = Node_val;
+	r->flags = (MALLOC|STRING|STRCUR|STRCAP);
+	r->valref = 1;
+	r->stfmt = STFMT_UNUSED;
+#ifdef HAVE_MPFR
+	r->strndmode = MPFR_round_mode;
+#endif
+	emalloc(r->stptr, char *, size);
+	memcpy(r->stptr, n->stptr, n->stlen);
+	r->stlen = n->stlen;
+	r->strcap = size;
+	DEREF(n);
+
+	return r;
+}
+
 /* make_typed_regex --- make a typed regex node */
 
 NODE *
@@ -539,7 +982,7 @@ r_unref(NODE *tmp)
 #endif
 
 	if ((tmp->flags & (MALLOC|STRCUR)) == (MALLOC|STRCUR))
-		efree(tmp->stptr);
+		free_stptr(tmp);
 
 	if ((tmp->flags & REGEX) != 0) {
 		refree(tmp->typed_re->re_reg[0]);
@@ -846,7 +1289,8 @@ str2wstr(NODE *n, size_t **ptr)
 		/* otherwise
 			fall through and recompute to fill in the array */
 		free_wstr(n);
-	}
+	} else if ((n->flags & CHARIDX) != 0)
+		free_wstr(n);	/* the wide string replaces it */
 
 	/*
 	 * After consideration and consultation, this
@@ -1003,10 +1447,226 @@ r_free_wstr(NODE *n)
 	if ((n->flags & WSTRCUR) != 0) {
 		assert(n->wstptr != NULL);
 		efree(n->wstptr);
-	}
+	} else if ((n->flags & CHARIDX) != 0 && n->charidx != NULL)
+		efree(n->charidx);
 	n->wstptr = NULL;
 	n->wstlen = 0;
-	n->flags &= ~WSTRCUR;
+	n->flags &= ~(WSTRCUR|ASCIISTR|CHARIDX);
+}
+
+/*
+ * A valid UTF-8 string can be indexed by character without building
+ * the wide string, which takes four times the space.  str2charidx()
+ * counts the characters into wstlen and notes the byte offset of every
+ * CHARIDX_STEP'th character in charidx; from the nearest mark, at most
+ * CHARIDX_STEP - 1 characters have to be stepped over.  Strings with
+ * fewer characters than that need no marks, and charidx is NULL.
+ */
+
+#define CHARIDX_STEP	64
+
+/* utf8_len --- the length of a UTF-8 sequence, 0 if it is not valid */
+
+static inline size_t
+utf8_len(const unsigned char *s, const unsigned char *end)
+{
+	unsigned char c = s[0];
+	size_t len, i;
+
+	if (c < 0x80)
+		return 1;
+	else if (c >= 0xC2 && c <= 0xDF)
+		len = 2;
+	else if (c >= 0xE0 && c <= 0xEF)
+		len = 3;
+	else if (c >= 0xF0 && c <= 0xF4)
+		len = 4;
+	else
+		return 0;
+
+	if ((size_t) (end - s) < len)
+		return 0;
+	for (i = 1; i < len; i++)
+		if ((s[i] & 0xC0) != 0x80)
+			return 0;
+
+	/* no overlong forms, surrogates, or values past U+10FFFF */
+	if (   (c == 0xE0 && s[1] < 0xA0)
+	    || (c == 0xED && s[1] >= 0xA0)
+	    || (c == 0xF0 && s[1] < 0x90)
+	    || (c == 0xF4 && s[1] >= 0x90))
+		return 0;
+
+	return len;
+}
+
+/* str2charidx --- build the character index of a string, if it can have one */
+
+/*
+ * Return false if the locale is not UTF-8, if the string is not valid
+ * UTF-8 (str2wstr() deals with that), or if the wide string is already
+ * there.
+ */
+
+bool
+str2charidx(NODE *n)
+{
+	const unsigned char *start = (const unsigned char *) n->stptr;
+	const unsigned char *s, *end = start + n->stlen;
+	size_t *marks = NULL;
+	size_t nchars = 0;
+	static int utf8 = -1;
+
+	assert(n->type == Node_val && (n->flags & STRCUR) != 0);
+
+	if ((n->flags & CHARIDX) != 0)
+		return true;
+	if (utf8 < 0)
+		utf8 = using_utf8();
+	if (! utf8 || (n->flags & WSTRCUR) != 0
+	    || n == Nnull_string || n == Null_field)
+		return false;
+
+	if (n->stlen >= CHARIDX_STEP)
+		emalloc(marks, size_t *, sizeof(size_t) * (n->stlen / CHARIDX_STEP + 1));
+
+	for (s = start; s < end; nchars++) {
+		size_t len = utf8_len(s, end);
+
+		if (len == 0) {
+			if (marks != NULL)
+				efree(marks);
+			return false;
+		}
+		if (nchars % CHARIDX_STEP == 0 && marks != NULL)
+			marks[nchars / CHARIDX_STEP] = s - start;
+		s += len;
+	}
+
+	if (nchars < CHARIDX_STEP && marks != NULL) {
+		efree(marks);
+		marks = NULL;
+	}
+
+	n->charidx = marks;
+	n->wstlen = nchars;
+	n->flags |= CHARIDX;
+	return true;
+}
+
+/* charidx_byte_offset --- where character charpos (from 0) of n starts */
+
+size_t
+charidx_byte_offset(NODE *n, size_t charpos)
+{
+	const unsigned char *s = (const unsigned char *) n->stptr;
+	const unsigned char *end = s + n->stlen;
+	size_t count;
+
+	assert((n->flags & CHARIDX) != 0);
+
+	if (charpos >= n->wstlen)
+		return n->stlen;
+
+	count = charpos;
+	if (n->charidx != NULL) {
+		s += n->charidx[charpos / CHARIDX_STEP];
+		count %= CHARIDX_STEP;
+	}
+	for (; count > 0; count--)
+		s += utf8_len(s, end);
+
+	return s - (const unsigned char *) n->stptr;
+}
+
+/* charidx_char_offset --- how many characters of n come before byte byteoff */
+
+size_t
+charidx_char_offset(NODE *n, size_t byteoff)
+{
+	const unsigned char *s = (const unsigned char *) n->stptr;
+	const unsigned char *end;
+	size_t count = 0;
+
+	assert((n->flags & CHARIDX) != 0 && byteoff <= n->stlen);
+
+	if (byteoff == n->stlen)
+		return n->wstlen;
+
+	if (n->charidx != NULL) {
+		/* find the last mark at or before byteoff */
+		size_t lo = 0, hi = (n->wstlen - 1) / CHARIDX_STEP;
+
+		while (lo < hi) {
+			size_t mid = (lo + hi + 1) / 2;
+
+			if (n->charidx[mid] <= byteoff)
+				lo = mid;
+			else
+				hi = mid - 1;
+		}
+		s += n->charidx[lo];
+		count = lo * CHARIDX_STEP;
+	}
+
+	/* count the bytes that start a character */
+	for (end = (const unsigned char *) n->stptr + byteoff; s < end; s++)
+		count += ((*s & 0xC0) != 0x80);
+
+	return count;
+}
+
+/* ascii_only --- true if the len bytes at str are all ASCII */
+
+bool
+ascii_only(const char *str, size_t len)
+{
+	const char *end = str + len;
+	unsigned char acc;
+
+	/* look for a set high bit, four 64-bit words at a time */
+	for (; end - str >= 32; str += 32) {
+		uint64_t w[4];
+
+		memcpy(w, str, sizeof(w));
+		if (((w[0] | w[1] | w[2] | w[3]) & 0x8080808080808080ULL) != 0)
+			return false;
+	}
+	for (acc = 0; str < end; str++)
+		acc |= (unsigned char) *str;
+
+	return (acc & 0x80) == 0;
+}
+
+/* ascii_case_is_plain --- true if the locale folds case on ASCII letters as C does */
+
+/*
+ * Not so in every locale: Turkish maps 'I' to dotless i.  Only when
+ * this is true may all-ASCII text be case-folded or compared without
+ * case a byte at a time in a multibyte locale.
+ */
+
+bool
+ascii_case_is_plain(void)
+{
+	static int plain = -1;
+	int c;
+
+	if (plain >= 0)
+		return plain;
+
+	plain = 1;
+	for (c = 'A'; c <= 'Z'; c++) {
+		int lc = c - 'A' + 'a';
+
+		if (towlower(c) != lc || towupper(lc) != c
+		    || tolower(c) != lc || toupper(lc) != c) {
+			plain = 0;
+			break;
+		}
+	}
+
+	return plain;
 }
 
 static void __attribute__ ((unused))
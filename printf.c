@@ -101,6 +101,179 @@ mpz2mpfr(mpz_ptr zi)
 }
 #endif
 
+/*
+ * Format plans.  Nearly every format is a constant that is used over
+ * and over again, so the flags, field width and precision of each
+ * conversion are parsed once and remembered.  format_args() then jumps
+ * from one conversion to the next without looking at the text in
+ * between.  Only plain `%[flags][width][.prec]c' conversions are
+ * planned; a format using `*', `$', a modifier or anything unusual
+ * is parsed every time, as before.
+ *
+ * Formatting an argument can call format_args() again, for CONVFMT or
+ * OFMT, so a plan that is in use is never evicted; the other format
+ * is then parsed the old way.
+ */
+
+struct format_spec {
+	size_t start;		/* offset of the `%' */
+	size_t conv;		/* offset of the conversion character */
+	long fw;
+	long prec;
+	bool have_prec;
+	bool lj;
+	bool alt;
+	bool zero;
+	bool space;
+	bool plus;
+	bool quote;
+	char signchar;
+};
+
+struct format_plan {
+	char *fmt;		/* private copy of the format */
+	size_t len;
+	bool usable;		/* false if the format can't be planned */
+	int in_use;		/* calls of format_args() working from it */
+	size_t nspecs;
+	struct format_spec *specs;
+};
+
+#define PLAN_CACHE_SIZE	64
+#define PLAN_MAX_NUMBER	100000	/* larger widths are left to format_args() */
+
+static struct format_plan *plan_cache[PLAN_CACHE_SIZE];
+
+/* make_format_plan --- parse a format into a plan */
+
+static struct format_plan *
+make_format_plan(const char *fmt, size_t len)
+{
+	struct format_plan *plan;
+	struct format_spec *spec;
+	size_t i, n;
+
+	for (i = n = 0; i < len; i++)
+		if (fmt[i] == '%')
+			n++;
+
+	emalloc(plan, struct format_plan *, sizeof(struct format_plan)
+			+ n * sizeof(struct format_spec) + len + 1);
+	plan->specs = (struct format_spec *) (plan + 1);
+	plan->fmt = (char *) (plan->specs + n);
+	memcpy(plan->fmt, fmt, len);
+	plan->fmt[len] = '\0';
+	plan->len = len;
+	plan->nspecs = 0;
+	plan->usable = false;
+	plan->in_use = 0;
+
+	for (i = 0; i < len; i++) {
+		if (fmt[i] != '%')
+			continue;
+
+		spec = & plan->specs[plan->nspecs++];
+		memset(spec, 0, sizeof(*spec));
+		spec->start = i++;
+
+		for (; i < len; i++) {
+			switch (fmt[i]) {
+			case '-':
+				spec->lj = true;
+				continue;
+			case '+':
+				spec->plus = true;
+				spec->signchar = '+';
+				continue;
+			case ' ':
+				spec->space = true;
+				if (spec->signchar == '\0')
+					spec->signchar = ' ';
+				continue;
+			case '#':
+				spec->alt = true;
+				continue;
+			case '0':
+				spec->zero = true;
+				continue;
+			case '\'':
+#if defined(HAVE_LOCALE_H)
+				spec->quote = true;
+#endif
+				continue;
+			}
+			break;
+		}
+
+		for (; i < len && isdigit((unsigned char) fmt[i]); i++)
+			if ((spec->fw = spec->fw * 10 + fmt[i] - '0') > PLAN_MAX_NUMBER)
+				return plan;
+
+		if (i < len && fmt[i] == '.') {
+			spec->have_prec = true;
+			for (i++; i < len && isdigit((unsigned char) fmt[i]); i++)
+				if ((spec->prec = spec->prec * 10 + fmt[i] - '0') > PLAN_MAX_NUMBER)
+					return plan;
+		}
+
+		if (i >= len)
+			return plan;
+
+		switch (fmt[i]) {
+		case '%':
+		case 'c':
+		case 's':
+		case 'd':
+		case 'i':
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'e':
+		case 'E':
+		case 'f':
+		case 'F':
+		case 'g':
+		case 'G':
+#if defined(PRINTF_HAS_A_FORMAT) && PRINTF_HAS_A_FORMAT == 1
+		case 'a':
+		case 'A':
+#endif
+			spec->conv = i;
+			break;
+		default:
+			return plan;
+		}
+	}
+
+	plan->usable = true;
+	return plan;
+}
+
+/* get_format_plan --- find the plan for a format, making it if need be */
+
+static struct format_plan *
+get_format_plan(const char *fmt, size_t len)
+{
+	struct format_plan **slot;
+
+	/* the plans assume that nothing needs to be diagnosed */
+	if (do_lint)
+		return NULL;
+
+	slot = & plan_cache[(((uintptr_t) fmt >> 3) ^ len) % PLAN_CACHE_SIZE];
+	if (*slot == NULL || (*slot)->len != len
+	    || memcmp((*slot)->fmt, fmt, len) != 0) {
+		if (*slot != NULL && (*slot)->in_use > 0)
+			return NULL;
+		if (*slot != NULL)
+			efree(*slot);
+		*slot = make_format_plan(fmt, len);
+	}
+
+	return (*slot)->usable ? *slot : NULL;
+}
+
 /*
  * format_args() formats arguments of sprintf,
  * and according to a fmt_string providing a format like in
@@ -190,6 +363,10 @@ format_args(
 	size_t copy_count, char_count;
 	bool magic_posix_flag;
 	struct flags flags;
+	struct format_plan *plan;
+	const struct format_spec *spec = NULL;
+	size_t next_spec = 0;
+	size_t fmt_len = n0;
 
 	static const char sp[] = " ";
 	static const char bad_modifiers[] = "DHhjLltwz";
@@ -241,10 +418,21 @@ format_args(
 
 	need_format = false;
 	used_dollar = false;
+	plan = get_format_plan(fmt_string, fmt_len);
+	if (plan != NULL)
+		plan->in_use++;
 
 	s0 = s1 = fmt_string;
 	while (n0-- > 0) {
-		if (*s1 != '%') {
+		if (plan != NULL) {
+			if (next_spec >= plan->nspecs) {
+				s1 = fmt_string + fmt_len;
+				break;
+			}
+			spec = & plan->specs[next_spec++];
+			s1 = fmt_string + spec->start;
+			n0 = fmt_len - spec->start - 1;
+		} else if (*s1 != '%') {
 			s1++;
 			continue;
 		}
@@ -272,6 +460,23 @@ format_args(
 		s1++;
 		memset(& flags, 0, sizeof(flags));
 
+		if (plan != NULL) {
+			/* everything up to the conversion character was parsed already */
+			fw = spec->fw;
+			prec = spec->prec;
+			have_prec = spec->have_prec;
+			lj = spec->lj;
+			alt = spec->alt;
+			zero_flag = spec->zero;
+			space_flag = spec->space;
+			plus_flag = spec->plus;
+			quote_flag = spec->quote;
+			signchar = spec->signchar;
+			cur = NULL;
+			s1 = fmt_string + spec->conv;
+			n0 = fmt_len - spec->conv;
+		}
+
 retry:
 		if (n0-- == 0)	/* ran out early! */
 			break;
@@ -581,7 +786,10 @@ out0:
 			if (fw == 0 && ! have_prec)
 				prec = arg->stlen;
 			else {
-				char_count = mbc_char_count(arg->stptr, arg->stlen);
+				/* in an all-ASCII string, bytes are characters */
+				char_count = mb_string(arg)
+					? mbc_char_count(arg->stptr, arg->stlen)
+					: arg->stlen;
 				if (! have_prec || prec > char_count)
 					prec = char_count;
 			}
@@ -597,7 +805,7 @@ out0:
 			if (fw == 0 && ! have_prec)
 				;
 			else if (gawk_mb_cur_max > 1) {
-				if (cs1 == 's') {
+				if (cs1 == 's' && mb_string(arg)) {
 					assert(cp == arg->stptr || cp == cpbuf.buf);
 					copy_count = mbc_byte_count(arg->stptr, prec);
 				}
@@ -620,6 +828,31 @@ out0:
 			(void) force_number(arg);
 			base = 10;
 
+			/*
+			 * Plain %d of a value that fits in 64 bits: put the
+			 * digits straight into the output.
+			 */
+			if (! lj && ! alt && ! zero_flag && ! space_flag
+			    && ! plus_flag && ! quote_flag && ! have_prec
+			    && (arg->flags & (MPFN|MPZN)) == 0
+			    && arg->numbr > -9223372036854775808.0
+			    && arg->numbr < 9223372036854775808.0) {
+				char digits[ITOA_BUFSIZE];
+
+				cp = fast_itoa((intmax_t) arg->numbr, digits + sizeof(digits));
+				len = digits + sizeof(digits) - cp;
+				chksize((size_t) fw + len)
+				for (; fw > (long) len; fw--) {
+					*obufout++ = ' ';
+					ofre--;
+				}
+				memcpy(obufout, cp, len);
+				ofre -= len;
+				obufout += len;
+				s0 = s1;
+				break;
+			}
+
 #define set_flags() \
 	flags.left_just = lj; \
 	flags.alt = alt; \
@@ -745,6 +978,9 @@ out0:
 	r = make_str_node(obuf, olen_final, ALREADY_MALLOCED);
 	obuf = NULL;
 out:
+	if (plan != NULL)
+		plan->in_use--;
+
 	if (cpbuf.buf != cpbuf.stackbuf)
 		efree(cpbuf.buf);
 
@@ -177,10 +177,11 @@ str_lookup(NODE *symbol, NODE *subs)
 	// 2. The string was from an unassigned variable.
 	// 3. The string was from a straight number, perniciously, from MPFR
 	// 4. The string was from an unassigned field.
+	// 5. The string is a view into a longer one.
 	if (   subs->stfmt != STFMT_UNUSED
 	    || subs == Nnull_string
 	    || (subs->flags & STRING) == 0
-	    || (subs->flags & (USER_INPUT|NULL_FIELD)) != 0) {
+	    || (subs->flags & (USER_INPUT|NULL_FIELD|STRVIEW)) != 0) {
 		NODE *tmp;
 
 		/*
@@ -209,6 +210,7 @@ str_lookup(NODE *symbol, NODE *subs)
 		/* string value already "frozen" */
 
 		subs = dupnode(subs);
+		settle_string(subs);
 	}
 
 	getbucket(b);
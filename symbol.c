@@ -196,6 +196,7 @@ lookup(const char *name)
 
 	tmp = get_name_from_awk_ns(name);
 
+again:
 	n = NULL;
 	for (i = 0; tables[i] != NULL; i++) {
 		if (assoc_empty(tables[i]))
@@ -209,6 +210,13 @@ lookup(const char *name)
 			break;
 	}
 
+	/* ENVIRON, PROCINFO and the builtins are only loaded when needed */
+	if (n == NULL) {
+		if (load_lazy_symbol(tmp->stptr))
+			goto again;
+	} else if (n == symbol_table || n == func_table)
+		(void) load_lazy_symbol(NULL);
+
 	unref(tmp);
 	if (n == NULL || n->type == Node_val)	/* non-variable in SYMTAB */
 		return NULL;
@@ -979,6 +987,8 @@ free_bc_internal(INSTRUCTION *cp)
 
 	switch(cp->opcode) {
 	case Op_func_call:
+	case Op_func_call_inline:
+	case Op_tail_call:
 		if (cp->func_name != NULL)
 			efree(cp->func_name);
 		break;
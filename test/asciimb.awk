@@ -0,0 +1,27 @@
+# Mix all-ASCII and multibyte strings in a UTF-8 locale, so that
+# the byte-at-a-time shortcuts for ASCII text get checked against
+# the wide character code.
+{
+	printf "%d %d %d|", length($0), length($2), index($0, "é")
+	for (i = 1; i <= NF; i++)
+		printf "%s:%s;", $i, substr($i, 2, 3)
+	printf "|%d %d|", match($0, /[a-zé]+/), RLENGTH
+	if (match($0, /.(.)/, m))
+		printf "%d %d|", m[1, "start"], m[1, "length"]
+	printf "%s|[%5.2s][%-6s]|", toupper($0), $1, $2
+
+	x = $1
+	x = x "b"
+	x = x "é"
+	printf "%d %s|", length(x), substr(x, length(x))
+
+	$2 = "ü"
+	printf "%d %d|", length($0), index($0, "ü")
+
+	n = split($1, a, "")
+	printf "%d %s|", n, a[n]
+
+	IGNORECASE = 1
+	print index($0, "B"), index($0, "É")
+	IGNORECASE = 0
+}
@@ -0,0 +1,67 @@
+# Concatenation may add onto the buffer of its first operand.  Make
+# sure that every value built that way, and every value that shared
+# the buffer before it grew, keeps its own text.
+
+function add(s, x)
+{
+	return s x ","
+}
+
+function quote(x)
+{
+	return "\"" x "\""
+}
+
+function show(name, v)
+{
+	printf("%s %d %s|%s\n", name, length(v), substr(v, 1, 12),
+		substr(v, length(v) - 11))
+}
+
+BEGIN {
+	for (i = 0; i < 300; i++) {
+		s = s quote(i) ":" i ","
+		t = s
+		u = s "tail"
+		s = s "+"
+		if (i % 7 == 0)
+			keep[i] = u
+		a["k"] = a["k"] i
+		b[i % 3] = b[i % 3] "<" a["k"] ">"
+		r = add(r, i)
+		v = v (i % 2 ? t : u)
+		if (t != substr(s, 1, length(t)))
+			print "bad t at", i
+		if (index(u, "tail") != length(u) - 3)
+			print "bad u at", i
+		seen[s]++
+		x = x i
+		y = x
+		x = x "-"
+		z = y "!"
+		if (substr(x, 1, length(y)) != y)
+			print "bad y at", i
+		n = split(s, parts, ",")
+		CONVFMT = (i % 2) ? "%.3g" : "%.6g"
+		CONVFMT = CONVFMT ""
+		fmt = CONVFMT "x"
+		num = (i / 3) ""
+	}
+	show("s", s); show("t", t); show("u", u)
+	show("a", a["k"]); show("b0", b[0]); show("b2", b[2])
+	show("r", r); show("v", v)
+	show("x", x); show("y", y); show("z", z)
+	for (k in keep)
+		total += length(keep[k])
+	for (k in seen)
+		count++
+	print total, count, n, parts[n - 1], num, fmt
+
+	FS = ","
+	FS = FS ""
+	fs2 = FS ":"
+	$0 = "a,b,c"
+	$0 = $0 ",d"
+	h = $0 ",e"
+	print NF, $4, h, $0, fs2
+}
@@ -0,0 +1,14 @@
+# Records and fields long enough that the CSV scanning works on whole
+# blocks, with quotes, doubled quotes and newlines at every position.
+BEGIN {
+	for (i = 0; i < 10000; i++)
+		long = long sprintf("%c", 97 + i % 26)
+	$0 = "\"" long "\"\"" long "\"," long ",\"x\ny\""
+	print NF, length($1), length($2), ($3 == "x\ny")
+}
+{
+	printf "%d: NF=%d", NR, NF
+	for (i = 1; i <= NF; i++)
+		printf " [%s]", $i
+	print ""
+}
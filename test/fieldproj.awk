@@ -0,0 +1,8 @@
+# Only $2 and $5 are used, so the other fields are not kept.
+# NF must still count all of them.
+{
+	print NR ":", NF, "[" $5 "]", "[" $2 "]"
+	if (NR == 2)
+		$0 = "a,b,c,d,e"
+	print "  [" $2 "]", "[" $5 "]", NF
+}
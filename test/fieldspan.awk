@@ -0,0 +1,28 @@
+# Fields are only filled in when they are used.  Make sure that
+# fields kept across records, NF changes and $0 rebuilds all see
+# the right values.
+{
+	keep[NR] = $2		# keep a reference past the next record
+	last = $NF
+	if (NR == 2) {
+		NF = 3		# truncate with unused fields
+		print "truncated:", $0, NF
+	} else if (NR == 3) {
+		$7 = "seven"	# assign past the end
+		print "extended:", $0, NF, "[" $5 "]"
+	} else if (NR == 4) {
+		$1 = "first"
+		print "rebuilt:", $0, $3, $NF
+		FS = ","
+		print "old FS still used:", $2
+	} else if (NR == 5) {
+		print "new FS:", $2, NF
+		$0 = "x y z"
+		print "reset:", $2, NF
+	} else
+		print NR ":", $1, last, NF
+}
+END {
+	for (i = 1; i <= NR; i++)
+		print "keep[" i "] =", keep[i]
+}
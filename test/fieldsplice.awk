@@ -0,0 +1,10 @@
+# Rebuilding $0 copies unused fields from the old record in runs.
+# Check the runs are broken wherever the old separators are not OFS.
+{ orig = $0 }
+NR % 7 == 1 { $3 = "X"; print }
+NR % 7 == 2 { OFS = "--"; $1 = $1; print; OFS = " " }
+NR % 7 == 3 { x = $2; $NF = "last"; print; print x }
+NR % 7 == 4 { $(NF+2) = "beyond"; print; print NF }
+NR % 7 == 5 { NF = 2; print; $5 = "e"; print }
+NR % 7 == 6 { $2 = ""; y = $4; $4 = y y; print; $0 = orig; $1 = "z"; print }
+NR % 7 == 0 { $1 = $3; $3 = $1 "!"; print; print $1, $3 }
@@ -0,0 +1,32 @@
+# Converting numbers to strings with the usual CONVFMT values is done
+# without sprintf(); compare the results with what sprintf() gives.
+
+BEGIN {
+	nformats = split("%.6g %g %.1g %.2g %.3g %.10g %.15g %.g %.0f %.1f %.2f %.3f %.6f %.12f", formats, " ")
+
+	# fractions, values around halfway points and powers of ten
+	n = 0
+	for (i = 1; i <= 3000; i++) {
+		value[++n] = i / 7
+		value[++n] = -i / 3 * 10 ^ (i % 25 - 12)
+		value[++n] = (i * 7919 % 1000000 + 0.5) * 10 ^ (i % 30 - 20)
+		value[++n] = (i % 1000 + 0.5) / 1000
+		value[++n] = 10 ^ (i % 40 - 20) * (1 - 1e-7 * (i % 3))
+		value[++n] = 0.125 * i + 1e-9 * (i % 5)
+	}
+
+	for (f = 1; f <= nformats; f++) {
+		CONVFMT = formats[f]
+		bad = 0
+		for (i = 1; i <= n; i++) {
+			x = value[i]
+			if (x == int(x))
+				continue
+			got = x ""
+			want = sprintf(CONVFMT, x)
+			if (got != want && bad++ < 5)
+				printf("%s: %s, not %s\n", CONVFMT, got, want)
+		}
+		printf("%s: %d differences\n", CONVFMT, bad)
+	}
+}
@@ -0,0 +1,24 @@
+# Common FPAT values are matched without the regexp matcher.  Check they
+# split the same way the regexp does, null fields included.
+BEGIN {
+	pats[1] = "[^,]+"
+	pats[2] = "[^,]*"
+	pats[3] = "[^[:space:]]+"
+	pats[4] = "([^,]*)|(\"[^\"]+\")"
+	pats[5] = "([^,]*)|(\"([^\"]|\"\")+\")"
+	pats[6] = "([^;]*)|(\"([^\"]|\"\")+\")"
+}
+{ lines[NR] = $0 }
+END {
+	for (p = 1; p <= 6; p++) {
+		FPAT = pats[p]
+		print "FPAT = " FPAT
+		for (l = 1; l <= NR; l++) {
+			$0 = lines[l]
+			printf "%d:", NF
+			for (i = 1; i <= NF; i++)
+				printf " <%s>", $i
+			print ""
+		}
+	}
+}
@@ -0,0 +1,48 @@
+# Test inlining of small functions.  The results must be the same
+# as for a real function call.
+
+function max(a, b) { return a > b ? a : b }
+function sq(x) { return x * x }
+function cls(s)
+{
+	if (s ~ /^[0-9]+$/)
+		return "num"
+	else if (s == "")
+		return "empty"
+	return "str"
+}
+function both(a, b) { return a && b || ! a && ! b }
+function cap(s) { return toupper(substr(s, 1, 1)) substr(s, 2) }
+function len(a) { return length(a) }
+function nothing(x) { return }
+function field(n) { return $n }
+function hyp(a, b) { return sqrt(sq(a) + sq(b)) }
+function sum3(a, b, c) { return a + b + c }
+function global() { return G " " G }
+
+BEGIN {
+	i = 0
+	print max(3, 5), max(i++, i++), i, max("abc", "abd")
+	print sq(7), sq(max(2, 3)) + 1, sum3(1, sq(2), max(3, sum3(1, 1, 1)))
+	print cls("123"), cls(""), cls("x1")
+	print both(1, 1), both(0, 0), both(1, 0), both("", "a")
+	print cap("hello") "|" cap("")
+	print hyp(3, 4)
+
+	# arrays and untyped variables take the slow path
+	arr[1]; arr[2]
+	print len(arr), len("four")
+	print max(u, 1), length(u), typeof(u)
+	print max(arr[3], 2), length(arr)
+	print "[" nothing(4) "]"
+	G = "g"
+	print global()
+
+	$0 = "a b c"
+	print field(2), field(NF), field(0)
+
+	x = 0
+	for (k = 0; k < 1000; k++)
+		x += sq(k % 10)
+	print x
+}
@@ -0,0 +1,12 @@
+# ENVIRON, PROCINFO and the builtins in FUNCTAB are loaded on first use.
+# Here the builtins are only needed by the indirect call, at run time.
+
+function indirect(name, arg)
+{
+	return @name(arg)
+}
+
+BEGIN {
+	print indirect("toupper", "builtins are there")
+	print indirect("length", ENVIRON["LAZYINIT"])
+}
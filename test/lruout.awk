@@ -0,0 +1,20 @@
+# With PROCINFO["MAX_OUTPUT_FILES"] set, the least recently used
+# output file is closed and then reopened for appending.
+BEGIN {
+	PROCINFO["MAX_OUTPUT_FILES"] = 2
+	for (r = 1; r <= 3; r++)
+		for (i = 1; i <= 4; i++)
+			print "pass", r > ("_lruout." i)
+	print "again" > "_lruout.4"
+	print "opens", PROCINFO["output_opens"]
+	print "evictions", PROCINFO["output_evictions"]
+	print "reopens", PROCINFO["output_reopens"]
+	for (i = 1; i <= 4; i++) {
+		f = "_lruout." i
+		close(f)
+		while ((getline line < f) > 0)
+			print f ": " line
+		close(f)
+	}
+	system("rm -f _lruout.*")
+}
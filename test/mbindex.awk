@@ -0,0 +1,15 @@
+# substr(), index(), length() and match() on multibyte strings long
+# enough to need several checkpoints in the character index.
+BEGIN {
+	for (i = 0; i < 300; i++)
+		s = s "é€" (i % 3 ? "a" : "𝄞")
+	print length(s)
+	for (i = 0; i <= 901; i += 61)
+		print i, substr(s, i, 7), length(substr(s, i))
+	print index(s, "aé€𝄞"), index(s, "𝄞é€a"), index(s, "aa")
+	t = substr(s, 500) "日本語"
+	print index(t, "日本"), length(t)
+	if (match(t, /(€)(a)(é+)/, m))
+		print RSTART, RLENGTH, m[1, "start"], m[2, "start"], m[3, "start"], m[3, "length"]
+	print match(t, /語$/), RSTART, RLENGTH
+}
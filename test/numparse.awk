@@ -0,0 +1,7 @@
+# Plain decimal numbers are converted without strtod(); make sure the
+# values and the strnum status come out as before, around the limits
+# of the fast conversion too.
+
+{
+	printf("%-32s %-7s %.17g\n", "\"" $0 "\"", typeof($0), $0 + 0)
+}
@@ -0,0 +1,50 @@
+# Test comparisons of values expected to be numbers
+
+function lt(a, b)
+{
+	return a < b
+}
+
+function count(n,	i, c)
+{
+	for (i = 1; i <= n; i++)
+		c++
+	return c
+}
+
+BEGIN {
+	# numeric loop counters
+	for (i = 0; i < 3; i++)
+		s += i
+	print "s =", s, "count(4) =", count(4)
+
+	# parameters that get strings
+	print lt(10, 9), lt("10", "9"), lt(2, "10"), lt(u1, u2)
+
+	# a variable only assigned numbers, changed through SYMTAB
+	v = 10
+	SYMTAB["v"] = "9x"
+	if (v < 10)
+		print "v < 10 is wrong"
+	else
+		print "v < 10 is false, v compares as a string"
+
+	# uninitialized variables
+	if (w == 0)
+		print "w == 0"
+	if (w == "")
+		print "w == \"\""
+	if (w < 1)
+		print "w < 1"
+
+	# not a number
+	nan = log(-1)
+	print (nan < 1), (nan > 1), (nan == nan), (nan != nan)
+
+	# the result of a comparison as a value
+	x = 3; y = 4
+	r = (x < y) + (x > y) * 10
+	print "r =", r
+	while (x-- > 0)
+		print "x =", x
+}
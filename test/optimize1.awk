@@ -0,0 +1,58 @@
+# Test the optimizations done after parsing: constant conditions,
+# including variables set with -v, and reuse of $n and length($n)
+
+function sq3()
+{
+	return $3 * $3
+}
+
+function chg()
+{
+	$0 = "z y"
+	return ""
+}
+
+BEGIN {
+	if (DEBUG)
+		print "debugging"
+	else
+		print "not debugging"
+	if (! DEBUG)
+		print "not DEBUG"
+	if (LEVEL > 1)
+		print "level above 1"
+	if (!(LEVEL >= 3))
+		print "level below 3"
+	if (1 == 2)
+		print "1 == 2"
+	if ("")
+		print "empty string is true"
+	if ("0")
+		print "string \"0\" is true"
+	while (0)
+		print "while (0)"
+	i = 0
+	do {
+		if (++i > 3)
+			break
+	} while (1)
+	print "i =", i
+	N = 0
+	if (N)
+		print "N is true"
+	N = 5
+	if (N)
+		print "N =", N
+	print (DEBUG ? "yes" : "no")
+}
+
+{
+	if (ASSIGNED)
+		print "ASSIGNED on the command line"
+	print $3 * $3, sq3()
+	print length($1) + length($1), length($2) * length($1)
+	print $2, $2, length($2), $2 $2
+	print ($1 > 0 ? $1 : -$1)
+	x = $1 chg() $1
+	print x
+}
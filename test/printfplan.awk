@@ -0,0 +1,17 @@
+# Formats are parsed once and then reused; make sure a reused
+# format gives the same results as a fresh one.
+BEGIN {
+	split("0 1 -1 42 -42 3.14159 -2.5 1e10 123456789012 0.000123 abc 17x", v, " ")
+	n = split("%d|%i|%5d|%-5d|%05d|%-05d|%+d|% d|%+ d|% +d|%.3d|%8.3d|%-8.3d|%x|%X|%#x|%#o|%o|%u|%08.3x|%e|%E|%.2e|%f|%.0f|%#.0f|%10.4f|%-10.4f|%+010.2f|%g|%G|%#g|%.10g|%s|%5s|%-5s|%.2s|%5.1s|%c|%5c|%%|%5%|%0-5d|%00005d|%-.05d|x%dy%sz", f, "|")
+	for (i = 1; i <= n; i++) {
+		for (j = 1; j in v; j++) {
+			x = (v[j] ~ /^[-0-9.e]+$/) ? v[j] + 0 : v[j]
+			printf("%s %s <" f[i] ">", f[i], v[j], x, x)
+			fmt = f[i]
+			s = sprintf(fmt, x, x)
+			printf(" <%s>\n", s)
+		}
+	}
+	printf "%*d|%-*d|%.*f|\n", 5, 3, 5, 3, 2, 3.14159
+	printf "%2$s %1$s\n", "a", "b"
+}
@@ -0,0 +1,18 @@
+# Converting a number for %s formats it with CONVFMT, which goes through
+# the plan cache again while the outer format's plan is being used.
+BEGIN {
+	CONVFMT = "%.3e"
+	for (i = 0; i < 2000; i++) {
+		fmt = sprintf("%%s %%s %%s %%s|%*s|\n", i % 97, "")
+		got = sprintf(fmt, 1.5 + i, 2.25, 3.125, "x")
+		want = sprintf("%.3e %.3e %.3e x|%*s|\n", 1.5 + i, 2.25, 3.125, i % 97, "")
+		if (got != want) {
+			bad++
+			if (bad <= 5)
+				printf "%d: got %s", i, got
+		}
+		if (i % 500 == 0)
+			printf "%s", got
+	}
+	print bad + 0, "bad"
+}
@@ -0,0 +1,15 @@
+# print and %d write integers directly; check the edge cases.
+BEGIN {
+	n = split("0 -0 1 -1 9 10 99 100 -100 12345 2^31 -2^31 2^53 -2^53 2^62 -2^62 2^63 -2^63 2^64 -0.5 3.9 -3.9 1e18 1e19", e, " ")
+	for (i = 1; i <= n; i++) {
+		x = e[i]
+		if (x ~ /\^/) {
+			split(x, p, "\\^")
+			v = (p[1] ~ /^-/) ? -(substr(p[1], 2) ^ p[2]) : p[1] ^ p[2]
+		} else
+			v = x + 0
+		printf "%s: ", x
+		print v, v + 0, -v
+		printf("%d|%i|%25d|%-25d|\n", v, v, v, v)
+	}
+}
@@ -0,0 +1,20 @@
+# Many redirections at once, some of them with the same name used
+# both for output and for input.
+BEGIN {
+	n = 200
+	for (r = 1; r <= 3; r++)
+		for (i = 1; i <= n; i++)
+			print "line", r, "of", i > ("_redirhash." i)
+	for (i = 1; i <= n; i += 50) {
+		f = "_redirhash." i
+		fflush(f)
+		while ((getline line < f) > 0)
+			print f ": " line
+		print "close:", close(f), close(f)
+	}
+	for (i = 1; i <= n; i++)
+		if (close("_redirhash." i) != 0 && i % 50 != 1)
+			print "close of", i, "failed"
+	print "close of unknown:", close("_redirhash.none")
+	system("rm -f _redirhash.*")
+}
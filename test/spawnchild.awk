@@ -0,0 +1,22 @@
+# Test the child setup for commands started by system(), print | cmd
+# and cmd | getline: exit statuses, inherited standard input and
+# output, and the default SIGPIPE disposition.
+BEGIN {
+	print "system exit 3:", system("exit 3")
+	print "system SIGPIPE:", system("kill -PIPE $$")
+
+	cmd = "read line; echo \"getline: $line\""
+	cmd | getline x
+	print x
+	print "close:", close(cmd)
+
+	cmd = "kill -PIPE $$"
+	cmd | getline x
+	print "close SIGPIPE:", close(cmd)
+
+	cmd = "cat; exit 5"
+	print "to a pipe" | cmd
+	print "close print pipe:", close(cmd)
+
+	print "system stdin:", system("read line; echo \"system: $line\"")
+}
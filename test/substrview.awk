@@ -0,0 +1,36 @@
+# Pieces of strings made by substr() and split() may share their
+# text with the string they came from.  Make sure they stay right
+# when the original changes or goes away.
+
+function piece(s,	t)
+{
+	t = substr(s, 2, 3)
+	s = "gone"
+	return t substr(t, 2)
+}
+
+{
+	a = substr($0, 1, 5)
+	b = substr($2, 2)
+	getline nxt
+	c = substr($0, 3, 6) "|" substr(nxt, 1, 3)
+	$0 = "new " substr($0, 1, 9)
+	print a, b, c, $0, piece(nxt)
+
+	n = split(nxt, arr, " ")
+	arr[1] = arr[1] "+"
+	x = arr[2]
+	sub(/e/, "E", arr[2])
+	nxt = ""
+	print n, arr[1], arr[2], x, arr[n], substr(arr[n], 2)
+
+	$2 = substr($1, 1, 2)
+	print $0, NF, (substr($0, 2) < $0), (substr($0, 1, 3) == "new")
+	m[substr($0, 1, 2)]++
+}
+
+END {
+	for (k in m)
+		print k, m[k]
+	print a, substr(a, 2, 2)
+}
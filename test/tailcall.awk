@@ -0,0 +1,28 @@
+# Test self tail calls, which reuse the frame of the running function.
+
+function loop(n, acc) { if (n == 0) return acc; return loop(n - 1, acc + 1) }
+function walk(a, k, s) { if (! (k in a)) return s; return walk(a, k + 1, s a[k]) }
+function even(n) { if (n == 0) return 1; return odd(n - 1) }
+function odd(n) { if (n == 0) return 0; return even(n - 1) }
+function fill(arr, n) { if (n == 0) return length(arr); arr[n] = n; return fill(arr, n - 1) }
+function loc(n,   L) { L[n]; if (n == 0) return length(L); return loc(n - 1, L) }
+function forin(a, n,   k) { for (k in a) return n ? forin(a, n - 1) : k }
+function args(a, b, c) { if (a == 0) return b "-" c; return args(a - 1, c, b) }
+function sub1(n, a,   L) { if (n == 0) return length(a) ":" a[1]; L[1][1] = n; return sub1(n - 1, L[1]) }
+function sub2(n, a) { if (n == 0) return length(a) ":" a[1]; return sub2(n - 1, a[1]) }
+
+BEGIN {
+	print loop(200000, 0)
+	for (i = 1; i <= 5; i++)
+		A[i] = i
+	print walk(A, 1, "")
+	print even(1000)
+	print fill(B, 1000), length(B)
+	print fill(U, 3), length(U)
+	print loc(5)
+	print forin(A, 3)
+	print args(3, "x", "y"), args(4, "x", "y")
+	print sub1(3, X)
+	Y[1][1][1][1] = 7
+	print sub2(3, Y)
+}